@@ -34,6 +34,9 @@ public:
 private:
     auto _get_resolution() noexcept -> int;
     auto _get_animation_mode() noexcept -> bool;
+    auto _get_progressive_mode() noexcept -> bool;
+    auto _get_look_ahead() noexcept -> span_size_t;
+    auto _get_frame_ring_size() noexcept -> span_size_t;
     auto _get_params() noexcept -> std::string;
     auto _get_animation_template() noexcept -> std::string;
 
@@ -45,6 +48,8 @@ private:
     auto _cube_map_load_handler() noexcept;
     auto _cube_map_fail_handler() noexcept;
     void _on_selected() noexcept;
+    auto _skybox_unit() noexcept -> oglplus::texture_unit;
+    void _present_next_frame() noexcept;
     auto _select_handler() noexcept;
     void _update_camera() noexcept;
     void _clear_background() noexcept;
@@ -55,6 +60,7 @@ private:
 
     auto _make_anim_url(long frame_no) noexcept -> url;
     auto _make_anim_url() noexcept -> url;
+    auto _make_full_image_url() noexcept -> url;
 
     video_context& _video;
 
@@ -66,11 +72,17 @@ private:
     const std::string _animation_template{_get_animation_template()};
     const int _resolution{_get_resolution()};
     const bool _animation_mode{_get_animation_mode()};
+    const span_size_t _look_ahead{_animation_mode ? _get_look_ahead() : 0};
+    // animation frames are not refined, they are replaced by the next ones
+    const bool _progressive_mode{
+      not _animation_mode and _get_progressive_mode()};
+    bool _refinement_requested{false};
     bool _anim_frame_ready{false};
     bool _show_setting_window{false};
 
     sky_viewer_backgrounds _backgrounds;
     sky_viewer_cube_maps _cube_maps;
+    sky_viewer_frame_ring _frames{_get_frame_ring_size()};
 };
 //------------------------------------------------------------------------------
 export auto establish(main_ctx&) -> unique_holder<launchpad>;
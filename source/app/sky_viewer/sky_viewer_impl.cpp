@@ -89,20 +89,48 @@ auto sky_viewer::_make_anim_url() noexcept -> url {
     query.append(std::to_string(_resolution));
     query.append("&params=");
     query.append(url::encode_component(_params));
+    if(_progressive_mode) {
+        query.append("&progressive=true");
+    }
+    return url{std::move(query)};
+}
+//------------------------------------------------------------------------------
+// In the progressive mode the full-resolution image replaces level zero
+// of the cube-map texture initially loaded with a low-resolution preview.
+auto sky_viewer::_make_full_image_url() noexcept -> url {
+    std::string query;
+    query.append("eagitexi:///cube_map_sky");
+    query.append("?size=");
+    query.append(std::to_string(_resolution));
+    query.append("&params=");
+    query.append(url::encode_component(_params));
     return url{std::move(query)};
 }
 //------------------------------------------------------------------------------
 void sky_viewer::_on_cube_map_loaded() noexcept {
-    if(_animation_mode) {
+    if(_frames) {
+        // the default cube map holds the first frame, the following ones
+        // are loaded ahead into the frame ring and presented in order
+        if(_anim_frame_no == 0) {
+            _anim_frame_ready = true;
+            for(long frame_no = 1; frame_no <= _frames.size(); ++frame_no) {
+                _frames.request(
+                  frame_no, _make_anim_url(frame_no), context(), _video);
+            }
+        }
+    } else if(_animation_mode) {
         ++_anim_frame_no;
         _cube_maps.update_default(
           context(), _video, _make_anim_url(_anim_frame_no));
         _anim_frame_ready = true;
+    } else if(_progressive_mode and not _refinement_requested) {
+        _refinement_requested = true;
+        _cube_maps.update_default(context(), _video, _make_full_image_url());
     }
 }
 //------------------------------------------------------------------------------
 void sky_viewer::_on_cube_map_failed() noexcept {
-    if(_animation_mode) {
+    if(_animation_mode and (not _frames or (_anim_frame_no == 0))) {
         _cube_maps.update_default(
           context(), _video, _make_anim_url(_anim_frame_no));
     }
@@ -111,11 +139,35 @@ void sky_viewer::_on_cube_map_failed() noexcept {
 void sky_viewer::_on_selected() noexcept {
     if(_backgrounds and _cube_maps) {
         _init_camera();
-        _backgrounds.set_skybox_unit(_video, _cube_maps.texture_unit(_video));
+        _backgrounds.set_skybox_unit(_video, _skybox_unit());
         _cube_maps.use(_video);
     }
 }
 //------------------------------------------------------------------------------
+auto sky_viewer::_skybox_unit() noexcept -> oglplus::texture_unit {
+    if(_frames and (_anim_frame_no > 0)) {
+        return _frames.texture_unit(_anim_frame_no);
+    }
+    return _cube_maps.texture_unit(_video);
+}
+//------------------------------------------------------------------------------
+void sky_viewer::_present_next_frame() noexcept {
+    const auto next_no{_anim_frame_no + 1};
+    if(_anim_frame_ready or not _frames.has_frame(next_no)) {
+        return;
+    }
+    const auto prev_no{std::exchange(_anim_frame_no, next_no)};
+    _anim_frame_ready = true;
+    if(_backgrounds) {
+        _backgrounds.set_skybox_unit(_video, _skybox_unit());
+    }
+    // the slot of the previously presented frame is free for a new frame
+    if(prev_no > 0) {
+        const auto frame_no{prev_no + _frames.size()};
+        _frames.request(frame_no, _make_anim_url(frame_no), context(), _video);
+    }
+}
+//------------------------------------------------------------------------------
 auto sky_viewer::_get_resolution() noexcept -> int {
     return from_string<valid_if_power_of_two<int>>(
              context().main_context().args().find("--resolution").next())
@@ -126,6 +178,35 @@ auto sky_viewer::_get_animation_mode() noexcept -> bool {
     return context().main_context().args().find("--animation");
 }
 //------------------------------------------------------------------------------
+auto sky_viewer::_get_progressive_mode() noexcept -> bool {
+    return context().main_context().args().find("--progressive");
+}
+//------------------------------------------------------------------------------
+auto sky_viewer::_get_look_ahead() noexcept -> span_size_t {
+    return std::max(
+      from_string<span_size_t>(
+        context().main_context().args().find("--look-ahead").next())
+        .value_or(3),
+      span_size(0));
+}
+//------------------------------------------------------------------------------
+// Each frame in the ring uses its own texture unit and the first unit is used
+// by the default cube-map, so the ring cannot be larger than the unit count.
+auto sky_viewer::_get_frame_ring_size() noexcept -> span_size_t {
+    if(_look_ahead <= 0) {
+        return 0;
+    }
+    auto size{_look_ahead + 1};
+    _video.with_gl([&](auto& gl, auto& GL) {
+        const auto max_units{GL.max_combined_texture_image_units};
+        if(const ok units{gl.get_integer(max_units)}) {
+            const auto frame_units{span_size(units.get()) - 1};
+            size = std::min(size, std::max(frame_units, span_size(0)));
+        }
+    });
+    return size;
+}
+//------------------------------------------------------------------------------
 auto sky_viewer::_get_params() noexcept -> std::string {
     if(url locator{context().main_context().args().find("--params").next()}) {
         return locator.release_string();
@@ -235,6 +316,10 @@ void sky_viewer::_update_camera() noexcept {
 }
 //------------------------------------------------------------------------------
 void sky_viewer::update() noexcept {
+    if(_frames) {
+        _frames.update(context(), _video);
+        _present_next_frame();
+    }
     _update_camera();
 
     _cube_maps.update();
@@ -252,6 +337,7 @@ void sky_viewer::update() noexcept {
 }
 //------------------------------------------------------------------------------
 void sky_viewer::clean_up() noexcept {
+    _frames.clean_up(context(), _video);
     _cube_maps.clean_up(context(), _video);
     _backgrounds.clean_up(context(), _video);
     _video.end();
@@ -48,9 +48,13 @@ public:
 
 private:
     void _on_loaded(const loaded_resource_base&) noexcept;
+    void _reset_base_level(video_context&) noexcept;
+
     oglplus::texture_target _tex_target;
     oglplus::texture_unit _tex_unit{0};
     bool _was_loaded{false};
+    bool _was_updating{false};
+    bool _base_level_outdated{false};
 };
 //------------------------------------------------------------------------------
 sky_viewer_texture_resource::sky_viewer_texture_resource(
@@ -69,6 +73,10 @@ sky_viewer_texture_resource::sky_viewer_texture_resource(
 void sky_viewer_texture_resource::_on_loaded(
   const loaded_resource_base& info) noexcept {
     _was_loaded = info.is_loaded();
+    if(std::exchange(_was_updating, false)) {
+        // the update may have filled in levels below the current base level
+        _base_level_outdated = _was_loaded;
+    }
     if(_was_loaded) {
         signal_loaded();
     } else {
@@ -101,9 +109,31 @@ void sky_viewer_texture_resource::request_update(
           _tex_target,
           texture_unit(video));
     });
+    _was_updating = true;
 }
 //------------------------------------------------------------------------------
-void sky_viewer_texture_resource::use(video_context&) {}
+// Only the level 0 image is complete after the update, the smaller mipmap
+// levels are not filled in, so the texture is limited to the base level.
+void sky_viewer_texture_resource::_reset_base_level(
+  video_context& video) noexcept {
+    video.with_gl([this](auto& gl, auto& GL) {
+        if(gl.texture_parameter_i) {
+            gl.texture_parameter_i(resource(), GL.texture_base_level, 0);
+            gl.texture_parameter_i(resource(), GL.texture_max_level, 0);
+        } else if(gl.tex_parameter_i) {
+            gl.active_texture(_tex_unit);
+            gl.bind_texture(_tex_target, resource());
+            gl.tex_parameter_i(_tex_target, GL.texture_base_level, 0);
+            gl.tex_parameter_i(_tex_target, GL.texture_max_level, 0);
+        }
+    });
+}
+//------------------------------------------------------------------------------
+void sky_viewer_texture_resource::use(video_context& video) {
+    if(std::exchange(_base_level_outdated, false)) {
+        _reset_base_level(video);
+    }
+}
 //------------------------------------------------------------------------------
 auto sky_viewer_texture_resource::texture_unit(video_context&)
   -> oglplus::texture_unit {
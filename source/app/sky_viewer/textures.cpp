@@ -28,4 +28,49 @@ public:
     auto texture_unit(video_context&) -> oglplus::texture_unit;
 };
 //------------------------------------------------------------------------------
+class sky_viewer_frame_slot;
+/// @brief Ring of cube-map textures into which the upcoming animation frames
+/// are loaded ahead of their presentation.
+/// @details Frame number N (starting with 1) is loaded into slot (N-1) % size.
+export class sky_viewer_frame_ring {
+public:
+    sky_viewer_frame_ring(span_size_t size);
+    sky_viewer_frame_ring(sky_viewer_frame_ring&&) = delete;
+    sky_viewer_frame_ring(const sky_viewer_frame_ring&) = delete;
+    auto operator=(sky_viewer_frame_ring&&) = delete;
+    auto operator=(const sky_viewer_frame_ring&) = delete;
+    ~sky_viewer_frame_ring() noexcept;
+
+    explicit operator bool() const noexcept {
+        return not _slots.empty();
+    }
+
+    auto size() const noexcept -> span_size_t {
+        return span_size(_slots.size());
+    }
+
+    /// @brief Requests the loading of the specified frame into its slot.
+    auto request(
+      long frame_no,
+      const url& locator,
+      execution_context&,
+      video_context&) -> sky_viewer_frame_ring&;
+
+    /// @brief Indicates if the specified frame is loaded in its slot.
+    auto has_frame(long frame_no) noexcept -> bool;
+
+    /// @brief Returns the texture unit of the slot of the specified frame.
+    auto texture_unit(long frame_no) noexcept -> oglplus::texture_unit;
+
+    /// @brief Re-requests the frames that failed to load.
+    void update(execution_context&, video_context&) noexcept;
+
+    void clean_up(execution_context&, video_context&);
+
+private:
+    auto _slot(long frame_no) noexcept -> sky_viewer_frame_slot&;
+
+    std::vector<unique_holder<sky_viewer_frame_slot>> _slots;
+};
+//------------------------------------------------------------------------------
 } // namespace eagine::app
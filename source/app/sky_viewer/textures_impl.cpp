@@ -48,5 +48,159 @@ auto sky_viewer_cube_maps::texture_unit(video_context& video)
     return current().texture_unit(video);
 }
 //------------------------------------------------------------------------------
+// Animation frame ring
+//------------------------------------------------------------------------------
+class sky_viewer_frame_slot {
+public:
+    sky_viewer_frame_slot(span_size_t index) noexcept
+      : _index{index} {}
+
+    auto frame_no() const noexcept -> long {
+        return _frame_no;
+    }
+
+    auto is_ready() const noexcept -> bool {
+        return _ready;
+    }
+
+    auto texture_unit() const noexcept -> oglplus::texture_unit {
+        return _tex_unit;
+    }
+
+    void request(
+      long frame_no,
+      const url& locator,
+      execution_context&,
+      video_context&);
+    void update(execution_context&, video_context&);
+    void clean_up(execution_context&, video_context&);
+
+private:
+    void _on_loaded() noexcept {
+        _ready = true;
+        _has_texture = true;
+    }
+
+    void _on_failed() noexcept {
+        _failed = true;
+    }
+
+    const span_size_t _index;
+    sky_viewer_texture _texture{{}};
+    oglplus::texture_unit _tex_unit{0};
+    url _locator;
+    long _frame_no{-1};
+    bool _ready{false};
+    bool _failed{false};
+    bool _has_texture{false};
+};
+//------------------------------------------------------------------------------
+void sky_viewer_frame_slot::request(
+  long frame_no,
+  const url& locator,
+  execution_context& ctx,
+  video_context& video) {
+    _frame_no = frame_no;
+    _locator = locator;
+    _ready = false;
+    _failed = false;
+    if(_texture.implementation()) {
+        // the texture of the presented frame is re-used for the new frame
+        _texture.request_update(_locator, ctx, video);
+    } else {
+        video.with_gl([&, this](auto&, auto& GL) {
+            // the first unit is used by the default cube-map
+            _tex_unit = GL.texture0 + int(_index + 1);
+            _texture = sky_viewer_texture{make_viewer_resource(
+              std::type_identity<sky_viewer_texture>{},
+              _locator,
+              ctx,
+              video,
+              GL.texture_cube_map,
+              _tex_unit)};
+        });
+        _texture.signals().loaded.connect(
+          make_callable_ref<&sky_viewer_frame_slot::_on_loaded>(this));
+        _texture.signals().failed.connect(
+          make_callable_ref<&sky_viewer_frame_slot::_on_failed>(this));
+        _texture.load_if_needed(ctx, video);
+    }
+}
+//------------------------------------------------------------------------------
+void sky_viewer_frame_slot::update(
+  execution_context& ctx,
+  video_context& video) {
+    if(std::exchange(_failed, false)) {
+        if(_has_texture) {
+            _texture.request_update(_locator, ctx, video);
+        } else {
+            _texture.load_if_needed(ctx, video);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+void sky_viewer_frame_slot::clean_up(
+  execution_context& ctx,
+  video_context& video) {
+    _texture.clean_up(ctx, video);
+}
+//------------------------------------------------------------------------------
+sky_viewer_frame_ring::sky_viewer_frame_ring(span_size_t size) {
+    _slots.reserve(std_size(size));
+    for(const auto index : integer_range(size)) {
+        _slots.emplace_back(hold<sky_viewer_frame_slot>, index);
+    }
+}
+//------------------------------------------------------------------------------
+sky_viewer_frame_ring::~sky_viewer_frame_ring() noexcept = default;
+//------------------------------------------------------------------------------
+auto sky_viewer_frame_ring::_slot(long frame_no) noexcept
+  -> sky_viewer_frame_slot& {
+    assert(frame_no > 0);
+    assert(not _slots.empty());
+    return *_slots[std_size((frame_no - 1) % long(_slots.size()))];
+}
+//------------------------------------------------------------------------------
+auto sky_viewer_frame_ring::request(
+  long frame_no,
+  const url& locator,
+  execution_context& ctx,
+  video_context& video) -> sky_viewer_frame_ring& {
+    auto& slot{_slot(frame_no)};
+    if(slot.frame_no() != frame_no) {
+        slot.request(frame_no, locator, ctx, video);
+    }
+    return *this;
+}
+//------------------------------------------------------------------------------
+auto sky_viewer_frame_ring::has_frame(long frame_no) noexcept -> bool {
+    if(_slots.empty() or (frame_no <= 0)) {
+        return false;
+    }
+    auto& slot{_slot(frame_no)};
+    return (slot.frame_no() == frame_no) and slot.is_ready();
+}
+//------------------------------------------------------------------------------
+auto sky_viewer_frame_ring::texture_unit(long frame_no) noexcept
+  -> oglplus::texture_unit {
+    return _slot(frame_no).texture_unit();
+}
+//------------------------------------------------------------------------------
+void sky_viewer_frame_ring::update(
+  execution_context& ctx,
+  video_context& video) noexcept {
+    for(auto& slot : _slots) {
+        slot->update(ctx, video);
+    }
+}
+//------------------------------------------------------------------------------
+void sky_viewer_frame_ring::clean_up(
+  execution_context& ctx,
+  video_context& video) {
+    for(auto& slot : _slots) {
+        slot->clean_up(ctx, video);
+    }
+}
+//------------------------------------------------------------------------------
 } // namespace eagine::app
 
@@ -13,6 +13,7 @@ export import :input;
 export import :state;
 export import :interface;
 export import :implementation;
+export import :data_filter;
 export import :framedump_raw;
 export import :old_resource_loader;
 export import :resource_loader;
@@ -0,0 +1,94 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+/// https://www.boost.org/LICENSE_1_0.txt
+///
+export module eagine.app:data_filter;
+
+import std;
+import eagine.core.types;
+import eagine.core.memory;
+import eagine.core.string;
+import eagine.core.runtime;
+
+namespace eagine::app {
+//------------------------------------------------------------------------------
+/// @brief Streaming encoder of the fast run-length ("rle") data filter.
+/// @details Each packet starts with a control byte. Values below 128 are
+/// followed by control + 1 literal bytes, values from 128 are followed by
+/// a single byte repeated control - 125 times.
+/// @see run_length_decoding
+export class run_length_encoding {
+public:
+    run_length_encoding(data_compressor::data_handler handler) noexcept
+      : _handler{handler} {}
+
+    /// @brief Encodes the next block of data.
+    auto next(const memory::const_block) noexcept -> bool;
+
+    /// @brief Encodes the pending bytes, must be called after the last block.
+    auto finish() noexcept -> bool;
+
+private:
+    void _end_run() noexcept;
+    void _flush_literals() noexcept;
+    auto _flush_output() noexcept -> bool;
+
+    data_compressor::data_handler _handler;
+    std::vector<byte> _output;
+    std::array<byte, 128> _literals{};
+    std::size_t _literal_count{0U};
+    byte _run_byte{0U};
+    std::size_t _run_count{0U};
+};
+//------------------------------------------------------------------------------
+/// @brief Streaming decoder of the fast run-length ("rle") data filter.
+/// @see run_length_encoding
+export class run_length_decoding {
+public:
+    run_length_decoding(data_compressor::data_handler handler) noexcept
+      : _handler{handler} {}
+
+    /// @brief Decodes the next block of data.
+    auto next(const memory::const_block) noexcept -> bool;
+
+    /// @brief Returns false if the encoded data ended inside of a packet.
+    auto finish() noexcept -> bool;
+
+private:
+    data_compressor::data_handler _handler;
+    std::vector<byte> _output;
+    std::size_t _literal_count{0U};
+    std::size_t _repeat_count{0U};
+};
+//------------------------------------------------------------------------------
+/// @brief Decodes streamed blob data with the specified data_filter.
+/// @details Handles the compression methods supported by the data_compressor
+/// and the run-length ("rle") filter.
+export class stream_data_decoding {
+public:
+    /// @brief Indicates if the named data_filter is supported.
+    static auto is_supported(const string_view filter) noexcept -> bool;
+
+    /// @brief Initializes the decoding, returns false if filter is unknown.
+    auto init(
+      const string_view filter,
+      memory::buffer_pool& buffers,
+      data_compressor::data_handler handler) noexcept -> bool;
+
+    auto is_initialized() const noexcept -> bool {
+        return _run_length.has_value() or _decompression.is_initialized();
+    }
+
+    void next(const memory::const_block) noexcept;
+
+    auto finish() noexcept -> bool;
+
+private:
+    stream_decompression _decompression;
+    std::optional<run_length_decoding> _run_length;
+};
+//------------------------------------------------------------------------------
+} // namespace eagine::app
@@ -0,0 +1,171 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+/// https://www.boost.org/LICENSE_1_0.txt
+///
+module eagine.app;
+
+import std;
+import eagine.core.types;
+import eagine.core.memory;
+import eagine.core.string;
+import eagine.core.reflection;
+import eagine.core.runtime;
+
+namespace eagine::app {
+//------------------------------------------------------------------------------
+// run_length_encoding
+//------------------------------------------------------------------------------
+// shorter runs are cheaper to store as a part of the literals
+static constexpr const std::size_t min_run_length{3U};
+static constexpr const std::size_t max_run_length{130U};
+//------------------------------------------------------------------------------
+void run_length_encoding::_flush_literals() noexcept {
+    if(_literal_count > 0U) {
+        _output.push_back(byte(_literal_count - 1U));
+        _output.insert(
+          _output.end(),
+          _literals.begin(),
+          _literals.begin() + std::ptrdiff_t(_literal_count));
+        _literal_count = 0U;
+    }
+}
+//------------------------------------------------------------------------------
+void run_length_encoding::_end_run() noexcept {
+    if(_run_count >= min_run_length) {
+        _flush_literals();
+        _output.push_back(byte(_run_count + 125U));
+        _output.push_back(_run_byte);
+    } else {
+        for(std::size_t i = 0U; i < _run_count; ++i) {
+            _literals[_literal_count++] = _run_byte;
+            if(_literal_count == _literals.size()) {
+                _flush_literals();
+            }
+        }
+    }
+    _run_count = 0U;
+}
+//------------------------------------------------------------------------------
+auto run_length_encoding::_flush_output() noexcept -> bool {
+    if(_output.empty()) {
+        return true;
+    }
+    const bool result{_handler(view(_output))};
+    _output.clear();
+    return result;
+}
+//------------------------------------------------------------------------------
+auto run_length_encoding::next(const memory::const_block blk) noexcept
+  -> bool {
+    try {
+        for(const byte b : blk) {
+            if(
+              (_run_count > 0U) and (b == _run_byte) and
+              (_run_count < max_run_length)) {
+                ++_run_count;
+            } else {
+                _end_run();
+                _run_byte = b;
+                _run_count = 1U;
+            }
+        }
+        return _flush_output();
+    } catch(...) {
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+auto run_length_encoding::finish() noexcept -> bool {
+    try {
+        _end_run();
+        _flush_literals();
+        return _flush_output();
+    } catch(...) {
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+// run_length_decoding
+//------------------------------------------------------------------------------
+auto run_length_decoding::next(memory::const_block blk) noexcept -> bool {
+    try {
+        while(not blk.empty()) {
+            if(_literal_count > 0U) {
+                const auto literals{head(blk, span_size(_literal_count))};
+                _output.insert(_output.end(), literals.begin(), literals.end());
+                _literal_count -= std_size(literals.size());
+                blk = skip(blk, literals.size());
+            } else if(_repeat_count > 0U) {
+                _output.insert(_output.end(), _repeat_count, blk[0]);
+                _repeat_count = 0U;
+                blk = skip(blk, 1);
+            } else {
+                const auto control{std::size_t(blk[0])};
+                if(control < 128U) {
+                    _literal_count = control + 1U;
+                } else {
+                    _repeat_count = control - 125U;
+                }
+                blk = skip(blk, 1);
+            }
+        }
+        bool result{true};
+        if(not _output.empty()) {
+            result = _handler(view(_output));
+            _output.clear();
+        }
+        return result;
+    } catch(...) {
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+auto run_length_decoding::finish() noexcept -> bool {
+    return (_literal_count == 0U) and (_repeat_count == 0U);
+}
+//------------------------------------------------------------------------------
+// stream_data_decoding
+//------------------------------------------------------------------------------
+auto stream_data_decoding::is_supported(const string_view filter) noexcept
+  -> bool {
+    return (filter == string_view{"rle"}) or
+           from_string<data_compression_method>(filter).has_value();
+}
+//------------------------------------------------------------------------------
+auto stream_data_decoding::init(
+  const string_view filter,
+  memory::buffer_pool& buffers,
+  data_compressor::data_handler handler) noexcept -> bool {
+    if(filter == string_view{"rle"}) {
+        _run_length.emplace(handler);
+        return true;
+    }
+    _run_length.reset();
+    if(const auto method{from_string<data_compression_method>(filter)}) {
+        _decompression = stream_decompression{
+          data_compressor{*method, buffers}, handler, *method};
+        return true;
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+void stream_data_decoding::next(const memory::const_block blk) noexcept {
+    if(_run_length) {
+        _run_length->next(blk);
+    } else {
+        _decompression.next(blk);
+    }
+}
+//------------------------------------------------------------------------------
+auto stream_data_decoding::finish() noexcept -> bool {
+    if(_run_length) {
+        return _run_length->finish();
+    }
+    _decompression.finish();
+    return true;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine::app
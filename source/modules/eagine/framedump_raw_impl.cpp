@@ -39,8 +39,11 @@ public:
 
 private:
     auto _write_to_file(const std::string&, const memory::const_block) -> bool;
+    auto _append_encoded(const memory::const_block) noexcept -> bool;
 
     string_view _prefix;
+    data_compression_level _compression{data_compression_level::highest};
+    bool _run_length{false};
     std::string _feedback;
     memory::buffer _pixeldata;
     memory::buffer _compressed;
@@ -49,6 +52,8 @@ private:
 auto raw_framedump::initialize(execution_context&, const video_options& opts)
   -> bool {
     _prefix = opts.framedump_prefix();
+    _compression = opts.framedump_compression();
+    _run_length = opts.framedump_run_length();
     log_info("frame dump prefix: ${prefix}").arg("prefix", "FsPath", _prefix);
     return true;
 }
@@ -68,6 +73,12 @@ inline auto raw_framedump::_write_to_file(
     return std::getline(std::cin, _feedback).good() and (_feedback == path);
 }
 //------------------------------------------------------------------------------
+auto raw_framedump::_append_encoded(const memory::const_block blk) noexcept
+  -> bool {
+    memory::append_to(blk, _compressed);
+    return true;
+}
+//------------------------------------------------------------------------------
 auto raw_framedump::dump_frame(
   const long frame_number,
   const int width,
@@ -84,12 +95,25 @@ auto raw_framedump::dump_frame(
          << enumerator_name<framedump_data_type>(type) << '-'
          << std::setfill('0') << std::setw(6) << frame_number;
 
+    if(_run_length) {
+        _compressed.clear();
+        run_length_encoding encoding{data_compressor::data_handler{
+          this,
+          member_function_constant_t<&raw_framedump::_append_encoded>{}}};
+        if(encoding.next(data) and encoding.finish()) {
+            path << ".rle";
+            return _write_to_file(path.str(), view(_compressed));
+        }
+        return _write_to_file(path.str(), data);
+    }
+
+    if(_compression == data_compression_level::none) {
+        return _write_to_file(path.str(), data);
+    }
+
     _compressed.clear();
     if(const auto packed{main_context().compressor().compress(
-         data_compression_method::zlib,
-         data,
-         _compressed,
-         data_compression_level::highest)}) {
+         data_compression_method::zlib, data, _compressed, _compression)}) {
         path << ".zlib";
         return _write_to_file(path.str(), packed);
     }
@@ -1121,6 +1121,10 @@ public:
         _locator_str = new_locator.release_string();
         if(const auto request{loader.request_gl_texture_update(
              request_parameters(), ctx.gl_context(), tgt, tu, *this)}) {
+            if(not _update_sig_key) {
+                _update_sig_key = connect<&loaded_resource::_handle_updated>(
+                  this, loader.gl_texture_images_loaded);
+            }
             _request_id = request.request_id();
             _status = resource_load_status::loading;
         }
@@ -1140,6 +1144,10 @@ public:
     /// @brief Cleans up this resource.
     void clean_up(old_resource_loader& loader, const oglplus::gl_api& glapi) {
         glapi.clean_up(std::move(resource()));
+        if(_update_sig_key) {
+            loader.gl_texture_images_loaded.disconnect(_update_sig_key);
+            _update_sig_key = {};
+        }
         common::_disconnect(loader);
     }
 
@@ -1156,6 +1164,20 @@ public:
     auto assign(const typename common::base_load_info& info) noexcept -> bool {
         return this->_assign(std::move(info.ref)) and this->has_value();
     }
+
+private:
+    // the updated images are stored into the already loaded texture object,
+    // so only the status changes and the load event is emitted again
+    void _handle_updated(
+      const old_resource_loader::gl_texture_images_load_info& info) noexcept {
+        if(info.request_id == _request_id) {
+            _status = resource_load_status::loaded;
+            load_event(*this);
+            _request_id = 0;
+        }
+    }
+
+    signal_binding_key _update_sig_key{};
 };
 export using gl_texture_resource = loaded_resource<oglplus::owned_texture_name>;
 //------------------------------------------------------------------------------
@@ -12,6 +12,7 @@ import eagine.core.types;
 import eagine.core.memory;
 import eagine.core.identifier;
 import eagine.core.valid_if;
+import eagine.core.runtime;
 import eagine.core.main_ctx;
 import :types;
 
@@ -347,6 +348,18 @@ public:
         return _framedump_stencil;
     }
 
+    /// @brief Returns the compression level of the frame dump image files.
+    /// @details Frames are dumped uncompressed, if the level is none.
+    auto framedump_compression() const noexcept -> data_compression_level {
+        return _framedump_compression;
+    }
+
+    /// @brief Indicates if the frames are dumped run-length encoded.
+    /// @details This is much faster than zlib and overrides the compression.
+    auto framedump_run_length() const noexcept -> bool {
+        return _framedump_run_length;
+    }
+
     /// @brief Indicates if a frame dump render run is requested.
     auto doing_framedump() const noexcept -> bool {
         return (_framedump_color != framedump_data_type::none) or
@@ -395,6 +408,8 @@ private:
     application_config_value<framedump_data_type> _framedump_depth;
     application_config_value<framedump_data_type> _framedump_stencil;
     application_config_value<valid_if_nonnegative<long>> _framedump_skip;
+    application_config_value<data_compression_level> _framedump_compression;
+    application_config_value<bool> _framedump_run_length;
 };
 //------------------------------------------------------------------------------
 /// @brief Class holding and managing audio-related application options.
@@ -13,6 +13,7 @@ import eagine.core.memory;
 import eagine.core.string;
 import eagine.core.identifier;
 import eagine.core.reflection;
+import eagine.core.runtime;
 import eagine.core.main_ctx;
 
 namespace eagine::app {
@@ -56,7 +57,9 @@ video_options::video_options(
   , _framedump_color{c, "application.video.framedump.color", instance, framedump_data_type::none}
   , _framedump_depth{c, "application.video.framedump.depth", instance, framedump_data_type::none}
   , _framedump_stencil{c, "application.video.framedump.stencil", instance, framedump_data_type::none}
-  , _framedump_skip{c, "application.video.framedump.skip_frames", instance, 0} {
+  , _framedump_skip{c, "application.video.framedump.skip_frames", instance, 0}
+  , _framedump_compression{c, "application.video.framedump.compression", instance, data_compression_level::highest}
+  , _framedump_run_length{c, "application.video.framedump.run_length", instance, false} {
 }
 //------------------------------------------------------------------------------
 // audio_options
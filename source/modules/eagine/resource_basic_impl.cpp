@@ -69,7 +69,7 @@ struct plain_text_resource::_loader final
 auto plain_text_resource::_loader::request_dependencies() noexcept
   -> valid_if_not_zero<identifier_t> {
     return add_single_loader_dependency(
-      parent_loader().fetch_resource_chunks(parameters(), 1024).first);
+      parent_loader().fetch_shared_chunks(parameters(), 1024));
 }
 //------------------------------------------------------------------------------
 void plain_text_resource::_loader::stream_data_appended(
@@ -118,7 +118,7 @@ struct string_list_resource::_loader final
 auto string_list_resource::_loader::request_dependencies() noexcept
   -> valid_if_not_zero<identifier_t> {
     return add_single_loader_dependency(
-      parent_loader().fetch_resource_chunks(parameters(), 1024).first);
+      parent_loader().fetch_shared_chunks(parameters(), 1024));
 }
 //------------------------------------------------------------------------------
 void string_list_resource::_loader::stream_data_appended(
@@ -172,7 +172,7 @@ struct url_list_resource::_loader final : simple_loader_of<url_list_resource> {
 auto url_list_resource::_loader::request_dependencies() noexcept
   -> valid_if_not_zero<identifier_t> {
     return add_single_loader_dependency(
-      parent_loader().fetch_resource_chunks(parameters(), 1024).first);
+      parent_loader().fetch_shared_chunks(parameters(), 1024));
 }
 //------------------------------------------------------------------------------
 void url_list_resource::_loader::stream_data_appended(
@@ -911,6 +911,7 @@ struct shape_generator_resource::_loader final
     void resource_loaded(const load_info&) noexcept final;
 
     valtree_resource _tree;
+    shape_generator_resource::resource_type _gen;
 };
 //------------------------------------------------------------------------------
 shape_generator_resource::_loader::_loader(
@@ -934,13 +935,19 @@ auto shape_generator_resource::_loader::request_dependencies() noexcept
 //------------------------------------------------------------------------------
 void shape_generator_resource::_loader::resource_loaded(
   const load_info& info) noexcept {
-    if(auto gen{
-         shapes::from_value_tree(_tree.release_resource(), main_ctx::get())}) {
-        resource()._private_ref() = std::move(gen);
-        mark_loaded();
-        return;
-    }
-    mark_error();
+    finish_in_background(
+      [this] {
+          _gen =
+            shapes::from_value_tree(_tree.release_resource(), main_ctx::get());
+      },
+      [this] {
+          if(_gen) {
+              resource()._private_ref() = std::move(_gen);
+              mark_loaded();
+          } else {
+              mark_error();
+          }
+      });
 }
 //------------------------------------------------------------------------------
 auto shape_generator_resource::make_loader(
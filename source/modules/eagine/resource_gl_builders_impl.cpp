@@ -256,7 +256,7 @@ public:
 
     auto append_image_data(const memory::const_block blk) noexcept -> bool;
 
-    auto init_decompression(data_compression_method method) noexcept -> bool;
+    auto init_decompression(const string_view filter) noexcept -> bool;
 
     auto max_token_size() noexcept -> span_size_t final {
         return 256;
@@ -290,7 +290,7 @@ public:
 private:
     main_ctx_buffer _tex_data;
     std::vector<float> _float_data;
-    stream_decompression _decompression;
+    stream_data_decoding _decompression;
     oglplus::texture_target _target;
     shared_holder<resource_gl_texture_image_params> _params{};
     bool _success{true};
@@ -310,14 +310,13 @@ auto valtree_gl_texture_image_loader::append_image_data(
 }
 //------------------------------------------------------------------------------
 auto valtree_gl_texture_image_loader::init_decompression(
-  data_compression_method method) noexcept -> bool {
+  const string_view filter) noexcept -> bool {
     if(const auto parent{_parent.lock()}) {
-        _decompression = stream_decompression{
-          data_compressor{method, parent->loader().buffers()},
+        return _decompression.init(
+          filter,
+          parent->loader().buffers(),
           make_callable_ref<&valtree_gl_texture_image_loader::append_image_data>(
-            this),
-          method};
-        return true;
+            this));
     }
     return false;
 }
@@ -400,12 +399,7 @@ void valtree_gl_texture_image_loader::do_add(
             _success &= texture_iformat_from_string(data, _params->iformat);
         } else if(path.starts_with("data_filter")) {
             if(data.has_single_value()) {
-                if(const auto method{
-                     from_string<data_compression_method>(*data)}) {
-                    _success &= init_decompression(*method);
-                } else {
-                    _success = false;
-                }
+                _success &= init_decompression(*data);
             } else {
                 _success = false;
             }
@@ -416,7 +410,7 @@ void valtree_gl_texture_image_loader::do_add(
 void valtree_gl_texture_image_loader::unparsed_data(
   span<const memory::const_block> data) noexcept {
     if(not _decompression.is_initialized()) {
-        _success &= init_decompression(data_compression_method::none);
+        _success &= init_decompression(string_view{"none"});
     }
     if(_success) {
         for(const auto& blk : data) {
@@ -428,7 +422,9 @@ void valtree_gl_texture_image_loader::unparsed_data(
 auto valtree_gl_texture_image_loader::finish() noexcept -> bool {
     if(const auto parent{_parent.lock()}) {
         if(_success) {
-            _decompression.finish();
+            _success = _decompression.finish();
+        }
+        if(_success) {
             parent->handle_gl_texture_image(_target, *_params, _tex_data);
         }
         parent->mark_finished();
@@ -483,7 +479,7 @@ public:
 
     auto append_image_data(const memory::const_block blk) noexcept -> bool;
 
-    auto init_decompression(data_compression_method method) noexcept -> bool;
+    auto init_decompression(const string_view filter) noexcept -> bool;
 
     auto max_token_size() noexcept -> span_size_t final {
         return 256;
@@ -515,7 +511,7 @@ public:
 private:
     oglplus::shared_gl_api_context _gl_context;
     main_ctx_buffer _tex_data;
-    stream_decompression _decompression;
+    stream_data_decoding _decompression;
     shared_holder<resource_gl_texture_params> _params{default_selector};
     url _image_locator;
     shared_holder<resource_gl_texture_image_params> _image_params{
@@ -545,14 +541,13 @@ auto valtree_gl_texture_builder::append_image_data(
 }
 //------------------------------------------------------------------------------
 auto valtree_gl_texture_builder::init_decompression(
-  data_compression_method method) noexcept -> bool {
+  const string_view filter) noexcept -> bool {
     if(const auto parent{_parent.lock()}) {
-        _decompression = stream_decompression{
-          data_compressor{method, parent->loader().buffers()},
+        return _decompression.init(
+          filter,
+          parent->loader().buffers(),
           make_callable_ref<&valtree_gl_texture_builder::append_image_data>(
-            this),
-          method};
-        return true;
+            this));
     }
     return false;
 }
@@ -562,8 +557,20 @@ void valtree_gl_texture_builder::do_add(
   const basic_string_path& path,
   const span<const T> data) noexcept {
     if(path.has_size(1)) {
+        using It = oglplus::gl_types::int_type;
+
         if(path.starts_with("levels")) {
             _success &= assign_if_fits(data, _params->levels);
+        } else if(path.starts_with("base_level")) {
+            It l{0};
+            if(_success &= assign_if_fits(data, l)) {
+                _i_params.emplace_back(0x813C, l);
+            }
+        } else if(path.starts_with("max_level")) {
+            It l{0};
+            if(_success &= assign_if_fits(data, l)) {
+                _i_params.emplace_back(0x813D, l);
+            }
         } else if(path.starts_with("width")) {
             _success &= assign_if_fits(data, _params->width);
             _params->dimensions = std::max(_params->dimensions, 1);
@@ -677,12 +684,7 @@ void valtree_gl_texture_builder::do_add(
             }
         } else if(path.starts_with("data_filter")) {
             if(data.has_single_value()) {
-                if(const auto method{
-                     from_string<data_compression_method>(*data)}) {
-                    _success &= init_decompression(*method);
-                } else {
-                    _success = false;
-                }
+                _success &= init_decompression(*data);
             } else {
                 _success = false;
             }
@@ -751,6 +753,9 @@ void valtree_gl_texture_builder::finish_object(
 //------------------------------------------------------------------------------
 auto valtree_gl_texture_builder::finish() noexcept -> bool {
     if(const auto parent{_parent.lock()}) {
+        if(_success and _decompression.is_initialized()) {
+            _success = _decompression.finish();
+        }
         if(_success and _decompression.is_initialized()) {
             resource_gl_texture_image_params img_params{
               .dimensions = _params->dimensions,
@@ -1182,6 +1187,11 @@ void pending_resource_info::_handle_gl_texture_image(
         if(const auto pgts{get_if<_pending_gl_texture_update_state>(_state)}) {
             _adjust_gl_texture_params(target, *pgts, tex_params);
             add_image_data(pgts->gl_context.gl_api(), *pgts, tex_params);
+            _parent.gl_texture_images_loaded(
+              {.request_id = _request_id,
+               .locator = _params.locator,
+               .gl_context = pgts->gl_context,
+               .name = pgts->tex});
         }
     }
     mark_finished();
@@ -124,6 +124,12 @@ public:
             return parameters().locator;
         }
 
+        /// @brief Returns the priority of the associated request.
+        auto priority() const noexcept -> msgbus::message_priority {
+            return parameters().priority.value_or(
+              msgbus::message_priority::normal);
+        }
+
         /// @brief Returns a downcast reference to the loaded resource.
         template <std::derived_from<resource_interface> Resource>
         auto resource_as() const noexcept -> Resource& {
@@ -156,6 +162,18 @@ public:
     protected:
         auto acquire_request_id() noexcept -> identifier_t;
 
+        /// @brief Runs work in a worker thread of the parent resource loader.
+        /// @details The continuation is scheduled on the thread calling
+        /// update_and_process_all of the loader. Besides this loader's own
+        /// state, the work may only use the logger and the buffer pool of
+        /// the main context (main_ctx::get()), which are safe to use from
+        /// multiple threads. It must not access the loaded resource, the
+        /// resource manager nor the state of other loaders; these must be
+        /// updated in the continuation.
+        void finish_in_background(
+          std::function<void()> work,
+          std::function<void()> continuation) noexcept;
+
         auto add_as_loader_consumer_of(
           valid_if_not_zero<identifier_t> req_id) noexcept
           -> valid_if_not_zero<identifier_t>;
@@ -269,6 +287,47 @@ protected:
     };
 };
 //------------------------------------------------------------------------------
+// resource_loader_workers
+//------------------------------------------------------------------------------
+// Threads running CPU-heavy finalization of loaded resources. The
+// continuations of finished work items are called by process_done.
+class resource_loader_workers {
+public:
+    resource_loader_workers() noexcept = default;
+    resource_loader_workers(resource_loader_workers&&) = delete;
+    resource_loader_workers(const resource_loader_workers&) = delete;
+    auto operator=(resource_loader_workers&&) = delete;
+    auto operator=(const resource_loader_workers&) = delete;
+    ~resource_loader_workers() noexcept;
+
+    auto is_started() const noexcept -> bool {
+        return _started;
+    }
+
+    void start(span_size_t count) noexcept;
+
+    void enqueue(
+      std::function<void()> work,
+      std::function<void()> continuation) noexcept;
+
+    auto has_pending() const noexcept -> bool;
+
+    auto process_done() noexcept -> work_done;
+
+private:
+    using work_item = std::pair<std::function<void()>, std::function<void()>>;
+
+    void _run(std::stop_token) noexcept;
+
+    mutable std::mutex _mutex;
+    std::condition_variable_any _cond;
+    std::deque<work_item> _queue;
+    std::vector<std::function<void()>> _done;
+    span_size_t _in_flight{0};
+    std::vector<std::jthread> _workers;
+    bool _started{false};
+};
+//------------------------------------------------------------------------------
 // resource_loader
 //------------------------------------------------------------------------------
 /// @brief Loader of resources of various types.
@@ -336,12 +395,67 @@ public:
       const std::shared_ptr<resource_interface::loader>& l) noexcept
       -> resource_loader&;
 
+    /// @brief Requests the chunks of the specified resource blob.
+    /// @see add_consumer
+    /// @note Requests with the same parameters and chunk size that did not
+    /// receive any data yet are shared and the chunks are passed to all
+    /// their consumers.
+    auto fetch_shared_chunks(
+      const resource_request_params& params,
+      span_size_t chunk_size) noexcept -> valid_if_not_zero<identifier_t>;
+
     /// @brief Does some work and updates internal state (should be called periodically).
     auto update_and_process_all() noexcept -> work_done final;
 
 private:
     friend class resource_interface::loader;
 
+    void _post_work(
+      std::function<void()> work,
+      std::function<void()> continuation) noexcept;
+
+    template <typename Function>
+    void _for_each_consumer(identifier_t request_id, Function func) noexcept {
+        if(const auto found{find(_consumer, request_id)}) {
+            // the consumers may add other consumers while being notified
+            const auto consumers{*found};
+            for(const auto& loader : consumers) {
+                if(loader) {
+                    func(loader);
+                }
+            }
+        }
+    }
+
+    struct _scheduled_task {
+        msgbus::message_priority priority;
+        std::uint64_t sequence;
+        std::function<void()> function;
+
+        // higher priority first, in the order of scheduling within a priority
+        static auto order(
+          const _scheduled_task& l,
+          const _scheduled_task& r) noexcept -> bool {
+            return std::tie(l.priority, r.sequence) <
+                   std::tie(r.priority, l.sequence);
+        }
+    };
+
+    void _schedule(
+      msgbus::message_priority priority,
+      std::function<void()> function) noexcept;
+
+    auto _frame_time_budget() noexcept -> std::chrono::steady_clock::duration;
+    auto _process_scheduled() noexcept -> work_done;
+
+    using _shared_fetch_key = std::tuple<
+      std::string,
+      span_size_t,
+      std::optional<std::chrono::seconds>,
+      std::optional<msgbus::message_priority>>;
+
+    void _forget_shared_fetch(identifier_t request_id) noexcept;
+
     void _handle_preparation_progressed(identifier_t blob_id, float) noexcept;
     void _handle_stream_data_appended(const msgbus::blob_stream_chunk&) noexcept;
     void _handle_stream_finished(identifier_t blob_id) noexcept;
@@ -364,7 +478,16 @@ private:
       const resource_status status) noexcept;
 
     flat_map<identifier_t, shared_holder<resource_interface::loader>> _pending;
-    flat_map<identifier_t, shared_holder<resource_interface::loader>> _consumer;
+    flat_map<
+      identifier_t,
+      std::vector<shared_holder<resource_interface::loader>>>
+      _consumer;
+    std::map<_shared_fetch_key, identifier_t> _shared_fetches;
+    std::map<identifier_t, _shared_fetch_key> _shared_fetch_keys;
+    std::vector<_scheduled_task> _scheduled;
+    std::uint64_t _schedule_sequence{0};
+    std::optional<std::chrono::steady_clock::duration> _time_budget;
+    resource_loader_workers _workers;
 };
 //------------------------------------------------------------------------------
 // simple_resource
@@ -94,6 +94,18 @@ auto resource_interface::loader::acquire_request_id() noexcept -> identifier_t {
     return _request_id;
 }
 //------------------------------------------------------------------------------
+void resource_interface::loader::finish_in_background(
+  std::function<void()> work,
+  std::function<void()> continuation) noexcept {
+    // the loader is kept alive until the continuation is called
+    parent_loader()._post_work(
+      std::move(work),
+      [self{shared_from_this()}, continuation{std::move(continuation)}] {
+          self->parent_loader()._schedule(
+            self->priority(), [self, continuation] { continuation(); });
+      });
+}
+//------------------------------------------------------------------------------
 auto resource_interface::loader::add_as_loader_consumer_of(
   valid_if_not_zero<identifier_t> req_id) noexcept
   -> valid_if_not_zero<identifier_t> {
@@ -183,6 +195,87 @@ void resource_interface::loader::mark_error(resource_status status) noexcept {
     _notify_error(parent_loader(), status);
 }
 //------------------------------------------------------------------------------
+// resource_loader_workers
+//------------------------------------------------------------------------------
+resource_loader_workers::~resource_loader_workers() noexcept {
+    for(auto& worker : _workers) {
+        worker.request_stop();
+    }
+    _cond.notify_all();
+    _workers.clear();
+}
+//------------------------------------------------------------------------------
+void resource_loader_workers::start(span_size_t count) noexcept {
+    _started = true;
+    try {
+        _workers.reserve(std_size(count));
+        for(span_size_t i = 0; i < count; ++i) {
+            _workers.emplace_back(
+              [this](std::stop_token stop) { _run(std::move(stop)); });
+        }
+    } catch(...) {
+    }
+}
+//------------------------------------------------------------------------------
+void resource_loader_workers::enqueue(
+  std::function<void()> work,
+  std::function<void()> continuation) noexcept {
+    try {
+        if(_workers.empty()) {
+            work();
+            const std::unique_lock lock{_mutex};
+            _done.emplace_back(std::move(continuation));
+        } else {
+            {
+                const std::unique_lock lock{_mutex};
+                _queue.emplace_back(std::move(work), std::move(continuation));
+                ++_in_flight;
+            }
+            _cond.notify_one();
+        }
+    } catch(...) {
+    }
+}
+//------------------------------------------------------------------------------
+void resource_loader_workers::_run(std::stop_token stop) noexcept {
+    while(true) {
+        work_item item;
+        {
+            std::unique_lock lock{_mutex};
+            if(not _cond.wait(
+                 lock, stop, [this] { return not _queue.empty(); })) {
+                break;
+            }
+            item = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        try {
+            item.first();
+        } catch(...) {
+        }
+        const std::unique_lock lock{_mutex};
+        _done.emplace_back(std::move(item.second));
+        --_in_flight;
+    }
+}
+//------------------------------------------------------------------------------
+auto resource_loader_workers::has_pending() const noexcept -> bool {
+    const std::unique_lock lock{_mutex};
+    return (_in_flight > 0) or not _done.empty();
+}
+//------------------------------------------------------------------------------
+auto resource_loader_workers::process_done() noexcept -> work_done {
+    std::vector<std::function<void()>> done;
+    {
+        const std::unique_lock lock{_mutex};
+        done.swap(_done);
+    }
+    for(auto& continuation : done) {
+        continuation();
+    }
+    return work_done{not done.empty()};
+}
+//------------------------------------------------------------------------------
 // resource_loader
 //------------------------------------------------------------------------------
 resource_loader::resource_loader(msgbus::endpoint& bus)
@@ -231,23 +324,114 @@ auto resource_loader::load_any(
 //------------------------------------------------------------------------------
 auto resource_loader::update_and_process_all() noexcept -> work_done {
     some_true something_done{base::update_and_process_all()};
-
-    // TODO
+    something_done(_workers.process_done());
+    something_done(_process_scheduled());
     return something_done;
 }
 //------------------------------------------------------------------------------
+void resource_loader::_post_work(
+  std::function<void()> work,
+  std::function<void()> continuation) noexcept {
+    if(not _workers.is_started()) {
+        const auto count{
+          app_config()
+            .get<span_size_t>("application.resource_loader.worker_threads")
+            .value_or(std::clamp(
+              span_size(std::thread::hardware_concurrency()) - 1,
+              span_size(0),
+              span_size(4)))};
+        _workers.start(std::max(count, span_size(0)));
+        log_info("started ${count} resource loader worker threads")
+          .arg("count", count);
+    }
+    _workers.enqueue(std::move(work), std::move(continuation));
+}
+//------------------------------------------------------------------------------
+void resource_loader::_schedule(
+  msgbus::message_priority priority,
+  std::function<void()> function) noexcept {
+    _scheduled.push_back(_scheduled_task{
+      .priority = priority,
+      .sequence = _schedule_sequence++,
+      .function = std::move(function)});
+    std::push_heap(
+      _scheduled.begin(), _scheduled.end(), &_scheduled_task::order);
+}
+//------------------------------------------------------------------------------
+auto resource_loader::_frame_time_budget() noexcept
+  -> std::chrono::steady_clock::duration {
+    if(not _time_budget) {
+        _time_budget = std::chrono::milliseconds{4};
+        if(const auto budget{app_config().get<std::chrono::microseconds>(
+             "application.resource_loader.frame_time_budget")}) {
+            _time_budget = std::max(*budget, std::chrono::microseconds{100});
+        }
+    }
+    return *_time_budget;
+}
+//------------------------------------------------------------------------------
+auto resource_loader::_process_scheduled() noexcept -> work_done {
+    if(_scheduled.empty()) {
+        return work_done{false};
+    }
+    // at least one task is finished in each update even if over budget
+    const auto deadline{
+      std::chrono::steady_clock::now() + _frame_time_budget()};
+    do {
+        std::pop_heap(
+          _scheduled.begin(), _scheduled.end(), &_scheduled_task::order);
+        auto task{std::move(_scheduled.back())};
+        _scheduled.pop_back();
+        task.function();
+    } while(not _scheduled.empty() and
+            std::chrono::steady_clock::now() < deadline);
+    return work_done{true};
+}
+//------------------------------------------------------------------------------
 auto resource_loader::has_pending_resources() const noexcept -> bool {
-    return not _pending.empty() or not _consumer.empty();
+    return not _pending.empty() or not _consumer.empty() or
+           not _scheduled.empty() or _workers.has_pending();
 }
 //------------------------------------------------------------------------------
 auto resource_loader::add_consumer(
   identifier_t request_id,
   const std::shared_ptr<resource_interface::loader>& l) noexcept
   -> resource_loader& {
-    _consumer[request_id] = {l};
+    _consumer[request_id].emplace_back(l);
     return *this;
 }
 //------------------------------------------------------------------------------
+auto resource_loader::fetch_shared_chunks(
+  const resource_request_params& params,
+  span_size_t chunk_size) noexcept -> valid_if_not_zero<identifier_t> {
+    _shared_fetch_key key{
+      params.locator.get_string(),
+      chunk_size,
+      params.max_time,
+      params.priority};
+    if(const auto pos{_shared_fetches.find(key)};
+       pos != _shared_fetches.end()) {
+        log_debug("sharing pending resource blob request ${reqId}")
+          .arg("reqId", pos->second)
+          .arg("url", "URL", std::get<0>(key));
+        return {pos->second};
+    }
+    const auto request_id{fetch_resource_chunks(params, chunk_size).first};
+    if(request_id) {
+        _shared_fetch_keys[request_id.value_anyway()] = key;
+        _shared_fetches[std::move(key)] = request_id.value_anyway();
+    }
+    return request_id;
+}
+//------------------------------------------------------------------------------
+void resource_loader::_forget_shared_fetch(identifier_t request_id) noexcept {
+    if(const auto pos{_shared_fetch_keys.find(request_id)};
+       pos != _shared_fetch_keys.end()) {
+        _shared_fetches.erase(pos->second);
+        _shared_fetch_keys.erase(pos);
+    }
+}
+//------------------------------------------------------------------------------
 void resource_loader::_handle_preparation_progressed(
   identifier_t blob_id,
   float) noexcept {
@@ -256,28 +440,32 @@ void resource_loader::_handle_preparation_progressed(
 //------------------------------------------------------------------------------
 void resource_loader::_handle_stream_data_appended(
   const msgbus::blob_stream_chunk& chunk) noexcept {
-    if(const auto found{find(_consumer, chunk.request_id)}) {
-        if(const auto& loader{*found}) {
-            loader->stream_data_appended(chunk);
-        }
-    }
+    // late requests cannot join once the first chunks were consumed
+    _forget_shared_fetch(chunk.request_id);
+    _for_each_consumer(chunk.request_id, [&](const auto& loader) {
+        loader->stream_data_appended(chunk);
+    });
 }
 //------------------------------------------------------------------------------
+// The finalization of the consumers is scheduled and done in the update
+// within the frame time budget.
 void resource_loader::_handle_stream_finished(identifier_t request_id) noexcept {
-    if(const auto found{find(_consumer, request_id)}) {
-        if(const auto& loader{*found}) {
+    _forget_shared_fetch(request_id);
+    _for_each_consumer(request_id, [&](const auto& loader) {
+        _schedule(loader->priority(), [loader, request_id] {
             loader->stream_finished(request_id);
-        }
-    }
+        });
+    });
 }
 //------------------------------------------------------------------------------
 void resource_loader::_handle_stream_cancelled(
   identifier_t request_id) noexcept {
-    if(const auto found{find(_consumer, request_id)}) {
-        if(const auto& loader{*found}) {
+    _forget_shared_fetch(request_id);
+    _for_each_consumer(request_id, [&](const auto& loader) {
+        _schedule(loader->priority(), [loader, request_id] {
             loader->stream_cancelled(request_id);
-        }
-    }
+        });
+    });
 }
 //------------------------------------------------------------------------------
 void resource_loader::_handle_resource_loaded(
@@ -287,11 +475,14 @@ void resource_loader::_handle_resource_loaded(
     const resource_interface::load_info info{
       locator, request_id, resource.kind(), resource_status::loaded};
 
-    if(const auto found{find(_consumer, request_id)}) {
-        if(const auto& loader{*found}) {
-            loader->resource_loaded(info);
-        }
-    }
+    _for_each_consumer(request_id, [&](const auto& loader) {
+        _schedule(
+          loader->priority(),
+          [loader, locator{url{locator}}, request_id, kind{info.kind}] {
+              loader->resource_loaded(
+                {locator, request_id, kind, resource_status::loaded});
+          });
+    });
     resource_loaded(info);
 }
 //------------------------------------------------------------------------------
@@ -302,11 +493,14 @@ void resource_loader::_handle_resource_cancelled(
     const resource_interface::load_info info{
       locator, request_id, resource.kind(), resource_status::cancelled};
 
-    if(const auto found{find(_consumer, request_id)}) {
-        if(const auto& loader{*found}) {
-            loader->resource_cancelled(info);
-        }
-    }
+    _for_each_consumer(request_id, [&](const auto& loader) {
+        _schedule(
+          loader->priority(),
+          [loader, locator{url{locator}}, request_id, kind{info.kind}] {
+              loader->resource_cancelled(
+                {locator, request_id, kind, resource_status::cancelled});
+          });
+    });
     resource_cancelled(info);
 }
 //------------------------------------------------------------------------------
@@ -318,11 +512,13 @@ void resource_loader::_handle_resource_error(
     const resource_interface::load_info info{
       locator, request_id, resource.kind(), status};
 
-    if(const auto found{find(_consumer, request_id)}) {
-        if(const auto& loader{*found}) {
-            loader->resource_error(info);
-        }
-    }
+    _for_each_consumer(request_id, [&](const auto& loader) {
+        _schedule(
+          loader->priority(),
+          [loader, locator{url{locator}}, request_id, kind{info.kind}, status] {
+              loader->resource_error({locator, request_id, kind, status});
+          });
+    });
     resource_error(info);
 }
 //------------------------------------------------------------------------------
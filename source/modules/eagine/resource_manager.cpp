@@ -73,6 +73,11 @@ class managed_resource_base;
 export class resource_manager {
 public:
     resource_manager(shared_holder<loaded_resource_context>) noexcept;
+    resource_manager(resource_manager&&) = delete;
+    resource_manager(const resource_manager&) = delete;
+    auto operator=(resource_manager&&) = delete;
+    auto operator=(const resource_manager&) = delete;
+    ~resource_manager() noexcept;
 
     [[nodiscard]] auto resource_context() const noexcept
       -> const shared_holder<loaded_resource_context>&;
@@ -106,13 +111,30 @@ private:
     auto _ensure_parameters(resource_request_params) noexcept
       -> const shared_holder<managed_resource_info>&;
 
+    auto _load(const shared_holder<managed_resource_info>&) noexcept
+      -> valid_if_not_zero<identifier_t>;
+
+    void _handle_load_finished(const resource_interface::load_info&) noexcept;
+
+    auto _request_unrequested() noexcept -> work_done;
+    auto _mark_loaded(resource_identifier res_id) noexcept -> bool;
+
     shared_holder<loaded_resource_context> _context;
+    signal_binding_key _loaded_key{};
+    signal_binding_key _cancelled_key{};
+    signal_binding_key _error_key{};
 
     chunk_map<resource_identifier, shared_holder<managed_resource_info>, 4096>
       _loaded;
 
-    // this has to be std::map for now, too many realocations happen when updating
-    std::map<resource_identifier, shared_holder<managed_resource_info>> _pending;
+    // nothing iterates over the pending resources in update, it only
+    // handles the ones that still need to be requested or have finished
+    flat_map<resource_identifier, shared_holder<managed_resource_info>>
+      _pending;
+    std::vector<resource_identifier> _unrequested;
+    std::vector<resource_identifier> _requesting;
+    std::vector<resource_identifier> _ready;
+    flat_map<identifier_t, resource_identifier> _requested;
 
     flat_map<
       resource_identifier,
@@ -78,6 +78,20 @@ resource_manager::resource_manager(
     assert(_context);
     _context->set(*this);
     _consumers.reserve(16);
+    auto& res_loader{loader()};
+    _loaded_key = connect<&resource_manager::_handle_load_finished>(
+      this, res_loader.resource_loaded);
+    _cancelled_key = connect<&resource_manager::_handle_load_finished>(
+      this, res_loader.resource_cancelled);
+    _error_key = connect<&resource_manager::_handle_load_finished>(
+      this, res_loader.resource_error);
+}
+//------------------------------------------------------------------------------
+resource_manager::~resource_manager() noexcept {
+    auto& res_loader{loader()};
+    res_loader.resource_loaded.disconnect(_loaded_key);
+    res_loader.resource_cancelled.disconnect(_cancelled_key);
+    res_loader.resource_error.disconnect(_error_key);
 }
 //------------------------------------------------------------------------------
 auto resource_manager::resource_context() const noexcept
@@ -104,9 +118,11 @@ auto resource_manager::_ensure_info(resource_identifier resource_id) noexcept
         return *found;
     }
     auto& info{_pending[resource_id]};
-    info.ensure();
-    info->resource_id = resource_id;
-
+    if(not info) {
+        info.ensure();
+        info->resource_id = resource_id;
+        _unrequested.push_back(resource_id);
+    }
     return info;
 }
 //------------------------------------------------------------------------------
@@ -148,29 +164,86 @@ auto resource_manager::add_consumer(
     return *this;
 }
 //------------------------------------------------------------------------------
-auto resource_manager::update() noexcept -> work_done {
+auto resource_manager::_load(
+  const shared_holder<managed_resource_info>& info) noexcept
+  -> valid_if_not_zero<identifier_t> {
+    assert(info);
+    auto req_id{info->load(loader(), _context)};
+    if(req_id) {
+        // the resource may get loaded right away if its dependencies are
+        if(info->is_loaded()) {
+            _ready.push_back(info->resource_id);
+        } else {
+            _requested[req_id.value_anyway()] = info->resource_id;
+        }
+    }
+    return req_id;
+}
+//------------------------------------------------------------------------------
+void resource_manager::_handle_load_finished(
+  const resource_interface::load_info& info) noexcept {
+    if(const auto found{find(_requested, info.request_id)}) {
+        _ready.push_back(*found);
+        _requested.erase(info.request_id);
+    }
+}
+//------------------------------------------------------------------------------
+auto resource_manager::_request_unrequested() noexcept -> work_done {
     some_true something_done;
-    auto& res_loader{loader()};
-    auto pos{_pending.begin()};
-    while(pos != _pending.end()) {
-        const auto& [res_id, info]{*pos};
+    // loading may create new managed resources, adding to the unrequested
+    _requesting.swap(_unrequested);
+    for(const auto res_id : _requesting) {
+        if(const auto found{find(_pending, res_id)}) {
+            const auto info{*found};
+            assert(info);
+            if(not info->resource or not info->has_parameters()) {
+                _unrequested.push_back(res_id);
+            } else if(info->resource->can_be_loaded()) {
+                if(_load(info)) {
+                    something_done();
+                } else {
+                    _unrequested.push_back(res_id);
+                }
+            } else if(info->is_loaded()) {
+                _ready.push_back(res_id);
+            } else if(not info->resource->is_loading()) {
+                // cancelled or failed resources are retried while pending
+                _unrequested.push_back(res_id);
+            }
+        }
+    }
+    _requesting.clear();
+    return something_done;
+}
+//------------------------------------------------------------------------------
+auto resource_manager::_mark_loaded(resource_identifier res_id) noexcept
+  -> bool {
+    if(const auto found{find(_pending, res_id)}) {
+        const auto info{*found};
         assert(info);
         if(info->is_loaded()) {
-            if(const auto found{find(_consumers, res_id)}) {
-                info->on_loaded(*found);
-                // intentionally not using found.position() here because
-                // on_loaded call above can cause pointer invalidation
+            _pending.erase(res_id);
+            _loaded[res_id] = info;
+            if(const auto consumers{find(_consumers, res_id)}) {
+                // the on_loaded call below can add other consumers
+                const auto loaders{std::move(*consumers)};
                 _consumers.erase(res_id);
+                info->on_loaded(loaders);
             }
-            _loaded[res_id] = std::move(info);
-            pos = _pending.erase(pos);
-            something_done();
-        } else if(auto req_id{info->load(res_loader, _context)}) {
-            something_done();
-            ++pos;
-        } else {
-            ++pos;
+            return true;
         }
+        // the load was cancelled or failed, the resource is tried again
+        _unrequested.push_back(res_id);
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+auto resource_manager::update() noexcept -> work_done {
+    some_true something_done{_request_unrequested()};
+    while(not _ready.empty()) {
+        const auto res_id{_ready.back()};
+        _ready.pop_back();
+        something_done(_mark_loaded(res_id));
     }
     return something_done;
 }
@@ -248,7 +321,7 @@ auto managed_resource_base::resource_id() const noexcept
 auto managed_resource_base::load_if_needed(
   resource_manager& manager) const noexcept -> valid_if_not_zero<identifier_t> {
     if(_info) {
-        return _info->load(manager.loader(), manager.resource_context());
+        return manager._load(_info);
     }
     return {0};
 }
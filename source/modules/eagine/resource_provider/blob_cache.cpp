@@ -0,0 +1,144 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+/// https://www.boost.org/LICENSE_1_0.txt
+///
+export module eagine.app.resource_provider:blob_cache;
+
+import eagine.core;
+import eagine.msgbus;
+import std;
+import :prepare_pool;
+
+namespace eagine::app {
+//------------------------------------------------------------------------------
+// memory_blob_cache
+//------------------------------------------------------------------------------
+/// @brief In-memory least-recently-used cache of blobs with a byte budget.
+/// @details Pinned blobs are kept outside of the budget and never evicted.
+export class memory_blob_cache : public main_ctx_object {
+public:
+    memory_blob_cache(
+      identifier id,
+      main_ctx_parent parent,
+      string_view budget_key,
+      span_size_t default_budget) noexcept;
+
+    auto max_entry_size() const noexcept -> span_size_t {
+        return _budget.value() / 4;
+    }
+
+    auto find(const std::string& key) noexcept
+      -> std::shared_ptr<const memory::buffer>;
+
+    void insert(
+      const std::string& key,
+      std::shared_ptr<const memory::buffer> content,
+      bool pinned = false) noexcept;
+
+private:
+    using entry = std::pair<std::string, std::shared_ptr<const memory::buffer>>;
+
+    application_config_value<span_size_t> _budget;
+    std::list<entry> _entries;
+    std::unordered_map<std::string, std::list<entry>::iterator> _index;
+    std::unordered_map<std::string, std::shared_ptr<const memory::buffer>>
+      _pinned;
+    span_size_t _total_size{0};
+};
+//------------------------------------------------------------------------------
+// blob_disk_cache
+//------------------------------------------------------------------------------
+/// @brief Directory of cached blob files with a byte budget.
+/// @details The blobs are written by work items in the blob preparation pool,
+/// so the index of the files is guarded by a mutex. The files are evicted
+/// in the order of their last use, except for the pinned ones.
+export class blob_disk_cache {
+public:
+    blob_disk_cache(std::filesystem::path directory, span_size_t budget) noexcept;
+
+    /// @brief Indexes the existing cache files, returns their count and size.
+    auto scan() noexcept -> std::pair<span_size_t, span_size_t>;
+
+    auto load(const std::string& key, bool pinned) noexcept
+      -> std::shared_ptr<const memory::buffer>;
+
+    /// @brief Returns false if the blob is already stored or being stored.
+    auto begin_store(const std::string& key, bool pinned) noexcept -> bool;
+
+    /// @brief Writes the blob started by begin_store, returns false on error.
+    auto store(
+      const std::string& key,
+      const memory::buffer& content,
+      bool pinned) noexcept -> bool;
+
+private:
+    using clock_time = std::filesystem::file_time_type;
+
+    struct entry {
+        span_size_t size{0};
+        // the end of the index for pinned entries
+        std::multimap<clock_time, std::filesystem::path>::iterator by_time;
+    };
+
+    auto _path(const std::string& key, bool pinned) const
+      -> std::filesystem::path;
+    void _insert(std::filesystem::path, span_size_t, clock_time, bool pinned);
+    void _trim() noexcept;
+
+    std::mutex _mutex;
+    const std::filesystem::path _directory;
+    const span_size_t _budget;
+    std::map<std::filesystem::path, entry> _entries;
+    std::multimap<clock_time, std::filesystem::path> _by_time;
+    std::set<std::filesystem::path> _storing;
+    span_size_t _total_size{0};
+};
+//------------------------------------------------------------------------------
+// generated_blob_cache
+//------------------------------------------------------------------------------
+/// @brief Cache of the content of deterministically generated resources.
+/// @details The content is keyed by the normalized resource locator salted
+/// with the generator version and settings of the provider, and kept in memory
+/// and optionally also in a directory on disk, so that it survives restarts
+/// of the resource provider.
+export class generated_blob_cache : public main_ctx_object {
+public:
+    generated_blob_cache(
+      main_ctx_parent parent,
+      blob_prepare_pool& workers) noexcept;
+
+    /// @brief Returns the locator string without fragment and with sorted query.
+    static auto normalized_key(const url& locator) -> std::string;
+
+    /// @brief Returns an I/O serving the cached content with the given key.
+    auto find_io(const std::string& key, bool pinned = false) noexcept
+      -> shared_holder<msgbus::source_blob_io>;
+
+    /// @brief Wraps the specified I/O so that the produced content is cached.
+    /// @details Pinned content is never evicted from the cache.
+    auto wrap_io(
+      std::string key,
+      shared_holder<msgbus::source_blob_io> io,
+      bool pinned = false) -> shared_holder<msgbus::source_blob_io>;
+
+    void store(
+      const std::string& key,
+      std::shared_ptr<const memory::buffer> content,
+      bool pinned) noexcept;
+
+private:
+    void _store_to_disk(
+      const std::string& key,
+      std::shared_ptr<const memory::buffer> content,
+      bool pinned) noexcept;
+
+    memory_blob_cache _memory;
+    blob_prepare_pool& _workers;
+    // shared with the work items storing the blobs, which can outlive this
+    std::shared_ptr<blob_disk_cache> _disk;
+};
+//------------------------------------------------------------------------------
+} // namespace eagine::app
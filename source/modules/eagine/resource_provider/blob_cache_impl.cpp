@@ -0,0 +1,479 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+/// https://www.boost.org/LICENSE_1_0.txt
+///
+module eagine.app.resource_provider;
+
+import eagine.core;
+import eagine.msgbus;
+import std;
+
+namespace eagine::app {
+//------------------------------------------------------------------------------
+// memory_blob_cache
+//------------------------------------------------------------------------------
+memory_blob_cache::memory_blob_cache(
+  identifier id,
+  main_ctx_parent parent,
+  string_view budget_key,
+  span_size_t default_budget) noexcept
+  : main_ctx_object{id, parent}
+  , _budget{main_context().config(), budget_key, default_budget} {}
+//------------------------------------------------------------------------------
+auto memory_blob_cache::find(const std::string& key) noexcept
+  -> std::shared_ptr<const memory::buffer> {
+    if(const auto pos{_pinned.find(key)}; pos != _pinned.end()) {
+        return pos->second;
+    }
+    if(const auto pos{_index.find(key)}; pos != _index.end()) {
+        // move to the most-recently-used position
+        _entries.splice(_entries.begin(), _entries, pos->second);
+        return pos->second->second;
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+void memory_blob_cache::insert(
+  const std::string& key,
+  std::shared_ptr<const memory::buffer> content,
+  bool pinned) noexcept {
+    if(not content) {
+        return;
+    }
+    if(pinned) {
+        try {
+            _pinned.emplace(key, std::move(content));
+        } catch(...) {
+        }
+        return;
+    }
+    if(content->size() > max_entry_size()) {
+        return;
+    }
+    if(_index.contains(key)) {
+        return;
+    }
+    _total_size += content->size();
+    _entries.emplace_front(key, std::move(content));
+    _index[key] = _entries.begin();
+
+    while((_total_size > _budget.value()) and not _entries.empty()) {
+        const auto& lru{_entries.back()};
+        _total_size -= lru.second->size();
+        _index.erase(lru.first);
+        _entries.pop_back();
+    }
+}
+//------------------------------------------------------------------------------
+// cached_source_blob_io
+//------------------------------------------------------------------------------
+class cached_source_blob_io final : public msgbus::source_blob_io {
+public:
+    cached_source_blob_io(std::shared_ptr<const memory::buffer> content) noexcept
+      : _content{std::move(content)} {}
+
+    auto total_size() noexcept -> span_size_t final {
+        return _content->size();
+    }
+
+    auto fetch_fragment(span_size_t offs, memory::block dst) noexcept
+      -> span_size_t final {
+        return copy(head(skip(view(*_content), offs), dst.size()), dst).size();
+    }
+
+private:
+    const std::shared_ptr<const memory::buffer> _content;
+};
+//------------------------------------------------------------------------------
+// caching_source_blob_io
+//------------------------------------------------------------------------------
+class caching_source_blob_io final : public msgbus::source_blob_io {
+public:
+    caching_source_blob_io(
+      generated_blob_cache& cache,
+      std::string key,
+      shared_holder<msgbus::source_blob_io> io,
+      bool pinned) noexcept
+      : _cache{cache}
+      , _key{std::move(key)}
+      , _io{std::move(io)}
+      , _pinned{pinned} {}
+
+    auto prepare() noexcept -> msgbus::blob_preparation_result final;
+
+    auto total_size() noexcept -> span_size_t final {
+        return _io->total_size();
+    }
+
+    auto fetch_fragment(span_size_t offs, memory::block dst) noexcept
+      -> span_size_t final;
+
+private:
+    void _store() noexcept;
+
+    generated_blob_cache& _cache;
+    const std::string _key;
+    shared_holder<msgbus::source_blob_io> _io;
+    const bool _pinned;
+    bool _stored{false};
+};
+//------------------------------------------------------------------------------
+auto caching_source_blob_io::prepare() noexcept
+  -> msgbus::blob_preparation_result {
+    const auto result{_io->prepare()};
+    if(result.has_finished()) {
+        _store();
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+auto caching_source_blob_io::fetch_fragment(
+  span_size_t offs,
+  memory::block dst) noexcept -> span_size_t {
+    const auto done{_io->fetch_fragment(offs, dst)};
+    if((done > 0) and (offs + done >= _io->total_size())) {
+        _store();
+    }
+    return done;
+}
+//------------------------------------------------------------------------------
+void caching_source_blob_io::_store() noexcept {
+    if(_stored) {
+        return;
+    }
+    _stored = true;
+    const auto size{_io->total_size()};
+    if(size <= 0) {
+        return;
+    }
+    try {
+        auto content{std::make_shared<memory::buffer>()};
+        content->resize(size);
+        if(_io->fetch_fragment(0, cover(*content)) == size) {
+            _cache.store(_key, std::move(content), _pinned);
+        }
+    } catch(...) {
+    }
+}
+//------------------------------------------------------------------------------
+// blob_disk_cache
+//------------------------------------------------------------------------------
+// Prefixed to the keys of the entries on disk, must be changed whenever
+// the layout of the cache files changes.
+static auto blob_cache_disk_key(const std::string& key) -> std::string {
+    return "eagiblob1 " + key;
+}
+//------------------------------------------------------------------------------
+blob_disk_cache::blob_disk_cache(
+  std::filesystem::path directory,
+  span_size_t budget) noexcept
+  : _directory{std::move(directory)}
+  , _budget{budget} {}
+//------------------------------------------------------------------------------
+// The pinned entries have a different extension, so that they can be
+// recognized when the directory is scanned.
+auto blob_disk_cache::_path(const std::string& key, bool pinned) const
+  -> std::filesystem::path {
+    return _directory / std::format(
+                          "{:016x}.{}",
+                          std::hash<std::string>{}(blob_cache_disk_key(key)),
+                          pinned ? "pinned" : "blob");
+}
+//------------------------------------------------------------------------------
+void blob_disk_cache::_insert(
+  std::filesystem::path path,
+  span_size_t size,
+  clock_time modified,
+  bool pinned) {
+    if(pinned) {
+        // not counted in the budget and never trimmed
+        _entries[std::move(path)] = {.size = size, .by_time = _by_time.end()};
+        return;
+    }
+    const auto by_time{_by_time.emplace(modified, path)};
+    _entries[std::move(path)] = {.size = size, .by_time = by_time};
+    _total_size += size;
+}
+//------------------------------------------------------------------------------
+void blob_disk_cache::_trim() noexcept {
+    while((_total_size > _budget) and not _by_time.empty()) {
+        const auto oldest{_by_time.begin()};
+        const auto pos{_entries.find(oldest->second)};
+        std::error_code error;
+        std::filesystem::remove(pos->first, error);
+        _total_size -= pos->second.size;
+        _entries.erase(pos);
+        _by_time.erase(oldest);
+    }
+}
+//------------------------------------------------------------------------------
+auto blob_disk_cache::scan() noexcept -> std::pair<span_size_t, span_size_t> {
+    const std::unique_lock lock{_mutex};
+    try {
+        for(const auto& entry :
+            std::filesystem::directory_iterator{_directory}) {
+            if(not entry.is_regular_file()) {
+                continue;
+            }
+            const auto extension{entry.path().extension()};
+            if((extension == ".blob") or (extension == ".pinned")) {
+                _insert(
+                  entry.path(),
+                  span_size(entry.file_size()),
+                  entry.last_write_time(),
+                  extension == ".pinned");
+            }
+        }
+    } catch(...) {
+    }
+    _trim();
+    return {span_size(_entries.size()), _total_size};
+}
+//------------------------------------------------------------------------------
+// The first line of each cache file contains the key, which is compared
+// on load to rule out collisions of the file name hashes.
+auto blob_disk_cache::load(const std::string& key, bool pinned) noexcept
+  -> std::shared_ptr<const memory::buffer> {
+    try {
+        const auto path{_path(key, pinned)};
+        span_size_t size{0};
+        {
+            const std::unique_lock lock{_mutex};
+            const auto pos{_entries.find(path)};
+            if(pos == _entries.end()) {
+                return {};
+            }
+            size = pos->second.size;
+            // refresh the time used for the eviction of old entries
+            if(pos->second.by_time != _by_time.end()) {
+                _by_time.erase(pos->second.by_time);
+                pos->second.by_time =
+                  _by_time.emplace(clock_time::clock::now(), path);
+            }
+        }
+        std::ifstream input{path, std::ios::in | std::ios::binary};
+        std::string stored_key;
+        if(
+          not std::getline(input, stored_key) or
+          (stored_key != blob_cache_disk_key(key))) {
+            return {};
+        }
+        const auto header_size{span_size(stored_key.size() + 1U)};
+        auto content{std::make_shared<memory::buffer>()};
+        content->resize(size - header_size);
+        if(not input.read(
+             reinterpret_cast<char*>(content->data()),
+             std::streamsize(content->size()))) {
+            return {};
+        }
+        std::error_code error;
+        std::filesystem::last_write_time(
+          path, clock_time::clock::now(), error);
+        return content;
+    } catch(...) {
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+auto blob_disk_cache::begin_store(const std::string& key, bool pinned) noexcept
+  -> bool {
+    try {
+        auto path{_path(key, pinned)};
+        const std::unique_lock lock{_mutex};
+        if(_entries.contains(path)) {
+            return false;
+        }
+        return _storing.insert(std::move(path)).second;
+    } catch(...) {
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+// The file is written without holding the lock, only the update
+// of the index is serialized with the loads and the other stores.
+auto blob_disk_cache::store(
+  const std::string& key,
+  const memory::buffer& content,
+  bool pinned) noexcept -> bool {
+    bool stored{false};
+    std::filesystem::path path;
+    try {
+        path = _path(key, pinned);
+        auto temp_path{path};
+        temp_path += ".tmp";
+        {
+            std::ofstream output{temp_path, std::ios::out | std::ios::binary};
+            output << blob_cache_disk_key(key) << '\n';
+            output.write(
+              reinterpret_cast<const char*>(content.data()),
+              std::streamsize(content.size()));
+            stored = bool(output);
+        }
+        if(stored) {
+            std::filesystem::rename(temp_path, path);
+        } else {
+            std::error_code error;
+            std::filesystem::remove(temp_path, error);
+        }
+    } catch(...) {
+        stored = false;
+    }
+    const std::unique_lock lock{_mutex};
+    _storing.erase(path);
+    if(stored) {
+        try {
+            _insert(
+              std::move(path),
+              span_size(blob_cache_disk_key(key).size() + 1U) + content.size(),
+              clock_time::clock::now(),
+              pinned);
+        } catch(...) {
+            stored = false;
+        }
+        _trim();
+    }
+    return stored;
+}
+//------------------------------------------------------------------------------
+// generated_blob_cache
+//------------------------------------------------------------------------------
+generated_blob_cache::generated_blob_cache(
+  main_ctx_parent parent,
+  blob_prepare_pool& workers) noexcept
+  : main_ctx_object{"GnBlobCach", parent}
+  , _memory{
+      "MemBlbCach",
+      as_parent(),
+      "application.resource_provider.blob_cache.memory_size",
+      span_size(256 * 1024 * 1024)}
+  , _workers{workers} {
+    // the disk tier is only used if a cache directory is configured
+    std::string directory;
+    main_context().config().fetch(
+      "application.resource_provider.blob_cache.directory", directory);
+    if(not directory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if(std::filesystem::is_directory(directory, error)) {
+            const auto budget{
+              app_config()
+                .get<span_size_t>(
+                  "application.resource_provider.blob_cache.disk_size")
+                .value_or(span_size(4) * 1024 * 1024 * 1024)};
+            try {
+                _disk = std::make_shared<blob_disk_cache>(directory, budget);
+                const auto [count, size]{_disk->scan()};
+                log_info("using blob cache directory ${path}")
+                  .arg("path", "FsPath", directory)
+                  .arg("count", count)
+                  .arg("size", "ByteSize", size)
+                  .arg("budget", "ByteSize", budget);
+            } catch(...) {
+                _disk.reset();
+            }
+        } else {
+            log_warning("cannot use blob cache directory ${path}")
+              .arg("path", "FsPath", directory);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+auto generated_blob_cache::normalized_key(const url& locator) -> std::string {
+    std::string_view str{locator.str()};
+    str = str.substr(0, str.find('#'));
+    const auto qpos{str.find('?')};
+    std::string result{str.substr(0, qpos)};
+    if(qpos != std::string_view::npos) {
+        std::vector<std::string_view> args;
+        auto query{str.substr(qpos + 1)};
+        while(not query.empty()) {
+            const auto amp{query.find('&')};
+            if(const auto arg{query.substr(0, amp)}; not arg.empty()) {
+                args.push_back(arg);
+            }
+            query.remove_prefix(
+              amp == std::string_view::npos ? query.size() : amp + 1);
+        }
+        std::ranges::sort(args);
+        char sep{'?'};
+        for(const auto arg : args) {
+            result.push_back(sep);
+            result.append(arg);
+            sep = '&';
+        }
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+auto generated_blob_cache::find_io(const std::string& key, bool pinned) noexcept
+  -> shared_holder<msgbus::source_blob_io> {
+    auto content{_memory.find(key)};
+    if(not content and _disk) {
+        if((content = _disk->load(key, pinned))) {
+            _memory.insert(key, content, pinned);
+        }
+    }
+    if(content) {
+        log_debug("serving ${locator} from the blob cache")
+          .arg("locator", key)
+          .arg("size", "ByteSize", content->size());
+        return {hold<cached_source_blob_io>, std::move(content)};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+auto generated_blob_cache::wrap_io(
+  std::string key,
+  shared_holder<msgbus::source_blob_io> io,
+  bool pinned) -> shared_holder<msgbus::source_blob_io> {
+    if(io) {
+        return {
+          hold<caching_source_blob_io>,
+          *this,
+          std::move(key),
+          std::move(io),
+          pinned};
+    }
+    return io;
+}
+//------------------------------------------------------------------------------
+void generated_blob_cache::store(
+  const std::string& key,
+  std::shared_ptr<const memory::buffer> content,
+  bool pinned) noexcept {
+    if(_disk) {
+        _store_to_disk(key, content, pinned);
+    }
+    _memory.insert(key, std::move(content), pinned);
+}
+//------------------------------------------------------------------------------
+// The blob files are written by the preparation workers, so that large
+// blobs do not stall the main loop. The work items share the ownership
+// of the disk cache and of the content, because they can outlive this.
+void generated_blob_cache::_store_to_disk(
+  const std::string& key,
+  std::shared_ptr<const memory::buffer> content,
+  bool pinned) noexcept {
+    if(not _disk->begin_store(key, pinned)) {
+        return;
+    }
+    if(_workers.has_workers()) {
+        try {
+            _workers.enqueue(
+              [disk{_disk}, key, content, pinned](const std::stop_token&) {
+                  disk->store(key, *content, pinned);
+              });
+            return;
+        } catch(...) {
+        }
+    }
+    if(not _disk->store(key, *content, pinned)) {
+        log_warning("failed to store ${locator} in the blob cache")
+          .arg("locator", key);
+    }
+}
+//------------------------------------------------------------------------------
+} // namespace eagine::app
@@ -63,6 +63,8 @@ protected:
     void append(const string_view);
     void append(const byte);
 
+    auto prepare() noexcept -> msgbus::blob_preparation_result override;
+
     auto total_size() noexcept -> span_size_t final;
 
     auto fetch_fragment(const span_size_t offs, memory::block dst) noexcept
@@ -70,6 +72,9 @@ protected:
 
 private:
     main_ctx_buffer _content;
+    // makes the content on the first call to prepare, so that it can be
+    // done off the main thread
+    std::function<memory::buffer(memory::buffer)> _make_content;
 };
 //------------------------------------------------------------------------------
 class compressed_buffer_source_blob_io : public simple_buffer_source_blob_io {
@@ -78,24 +83,33 @@ public:
     void compress(const string_view) noexcept;
     void compress(const byte) noexcept;
 
+    /// @brief Returns the data_filter value for the header of the blob.
+    auto data_filter() const noexcept -> string_view {
+        return _compression.data_filter();
+    }
+
 protected:
     compressed_buffer_source_blob_io(
       identifier id,
       main_ctx_parent parent,
-      span_size_t buffer_size) noexcept;
+      span_size_t buffer_size,
+      const blob_compression& compression = {}) noexcept;
 
     compressed_buffer_source_blob_io(
       identifier id,
       main_ctx_parent parent,
       span_size_t buffer_size,
-      std::function<memory::buffer(memory::buffer)>) noexcept;
+      std::function<memory::buffer(memory::buffer)>,
+      const blob_compression& compression = {}) noexcept;
 
     void finish() noexcept;
 
 private:
     auto _append_compressed(const memory::const_block) noexcept -> bool;
     auto _compress_handler() noexcept;
+    const blob_compression _compression;
     stream_compression _compress;
+    run_length_encoding _run_length;
 };
 //------------------------------------------------------------------------------
 class gl_rendered_source_blob_io : public compressed_buffer_source_blob_io {
@@ -110,6 +124,12 @@ public:
         return _params;
     }
 
+    /// @brief Compresses the data of the specified part of the blob.
+    /// @details The parts can be rendered by several contexts and be finished
+    /// out of order, so the parts following a missing one are kept until
+    /// the missing one is compressed.
+    void compress_part(span_size_t part, const memory::const_block) noexcept;
+
 protected:
     gl_rendered_source_blob_io(
       identifier id,
@@ -133,15 +153,36 @@ protected:
         return msgbus::blob_preparation_result::finished();
     }
 
-    virtual auto make_renderer(shared_holder<gl_rendered_blob_context>)
+    /// @brief Returns the number of parts among which contexts can be split.
+    virtual auto render_part_count() const noexcept -> int {
+        return 1;
+    }
+
+    virtual auto make_renderer(
+      const gl_rendered_blob_params&,
+      shared_holder<gl_rendered_blob_context>)
       -> unique_holder<gl_blob_renderer> = 0;
 
 private:
-    auto _create_context() noexcept -> shared_holder<gl_rendered_blob_context>;
+    struct context_renderer {
+        gl_rendered_blob_params params;
+        shared_holder<gl_rendered_blob_context> context;
+        unique_holder<gl_blob_renderer> renderer;
+        float progress{0.F};
+        bool finished{false};
+    };
+
+    auto _create_context(const gl_rendered_blob_params&) noexcept
+      -> shared_holder<gl_rendered_blob_context>;
+    auto _create_renderers() -> bool;
+    auto _render() noexcept -> msgbus::blob_preparation_result;
+    void _release_renderers() noexcept;
 
     const shared_provider_objects& _shared;
     const gl_rendered_blob_params _params;
-    unique_holder<gl_blob_renderer> _renderer;
+    std::vector<context_renderer> _renderers;
+    std::map<span_size_t, std::vector<byte>> _staged_parts;
+    span_size_t _next_part{0};
     bool _finished{false};
 };
 //------------------------------------------------------------------------------
@@ -158,6 +199,48 @@ private:
     std::stringstream _content;
 };
 //------------------------------------------------------------------------------
+// read-only file shared by concurrent requests
+//------------------------------------------------------------------------------
+class shared_file {
+public:
+    /// @param map Indicates that the file should be mapped into memory,
+    ///        it is read with pread if it cannot be mapped.
+    shared_file(
+      const std::filesystem::path& path,
+      span_size_t size,
+      std::filesystem::file_time_type modified,
+      bool map = false) noexcept;
+    shared_file(shared_file&&) = delete;
+    shared_file(const shared_file&) = delete;
+    auto operator=(shared_file&&) = delete;
+    auto operator=(const shared_file&) = delete;
+    ~shared_file() noexcept;
+
+    auto is_same(span_size_t size, std::filesystem::file_time_type modified)
+      const noexcept -> bool {
+        return (_size == size) and (_modified == modified);
+    }
+
+    auto size() const noexcept -> span_size_t {
+        return _size;
+    }
+
+    /// @brief Indicates if the file could be opened for reading.
+    auto is_open() const noexcept -> bool;
+
+    /// @brief Returns the mapped content, empty if the file is not mapped.
+    auto mapped() const noexcept -> memory::const_block;
+
+    auto read(span_size_t offs, memory::block dst) noexcept -> span_size_t;
+
+private:
+    const std::filesystem::path _path;
+    const span_size_t _size;
+    const std::filesystem::file_time_type _modified;
+    int _fd{-1};
+    void* _addr{nullptr};
+};
+//------------------------------------------------------------------------------
 // base provider implementations
 //------------------------------------------------------------------------------
 struct eagitex_provider_base
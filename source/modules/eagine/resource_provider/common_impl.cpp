@@ -9,6 +9,22 @@ module;
 
 #include <cassert>
 
+#if __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#define EAGINE_APP_HAS_PREAD 1
+#else
+#define EAGINE_APP_HAS_PREAD 0
+#endif
+
+#if EAGINE_APP_HAS_PREAD && __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#define EAGINE_APP_HAS_MMAP 1
+#else
+#define EAGINE_APP_HAS_MMAP 0
+#endif
+
 module eagine.app.resource_provider;
 
 import eagine.core;
@@ -75,7 +91,8 @@ simple_buffer_source_blob_io::simple_buffer_source_blob_io(
   span_size_t buffer_size,
   std::function<memory::buffer(memory::buffer)> make_content) noexcept
   : main_ctx_object{id, parent}
-  , _content{*this, make_content(main_context().buffers().get(buffer_size))} {}
+  , _content{*this, buffer_size}
+  , _make_content{std::move(make_content)} {}
 //------------------------------------------------------------------------------
 void simple_buffer_source_blob_io::append(const memory::const_block part) {
     memory::append_to(part, _content);
@@ -89,6 +106,21 @@ void simple_buffer_source_blob_io::append(const byte b) {
     append(view_one(b));
 }
 //------------------------------------------------------------------------------
+auto simple_buffer_source_blob_io::prepare() noexcept
+  -> msgbus::blob_preparation_result {
+    if(_make_content) {
+        memory::buffer& content{_content};
+        try {
+            content = _make_content(std::move(content));
+        } catch(...) {
+            _make_content = {};
+            return {msgbus::blob_preparation_status::failed};
+        }
+        _make_content = {};
+    }
+    return msgbus::blob_preparation_result::finished();
+}
+//------------------------------------------------------------------------------
 auto simple_buffer_source_blob_io::total_size() noexcept -> span_size_t {
     return span_size(_content.size());
 }
@@ -117,27 +149,39 @@ auto compressed_buffer_source_blob_io::_compress_handler() noexcept {
 compressed_buffer_source_blob_io::compressed_buffer_source_blob_io(
   identifier id,
   main_ctx_parent parent,
-  span_size_t buffer_size) noexcept
+  span_size_t buffer_size,
+  const blob_compression& compression) noexcept
   : simple_buffer_source_blob_io{id, parent, buffer_size}
+  , _compression{compression}
   , _compress{
       main_context().compressor(),
       _compress_handler(),
-      default_data_compression_method()} {}
+      default_data_compression_method()}
+  , _run_length{_compress_handler()} {}
 //------------------------------------------------------------------------------
 compressed_buffer_source_blob_io::compressed_buffer_source_blob_io(
   identifier id,
   main_ctx_parent parent,
   span_size_t buffer_size,
-  std::function<memory::buffer(memory::buffer)> func) noexcept
+  std::function<memory::buffer(memory::buffer)> func,
+  const blob_compression& compression) noexcept
   : simple_buffer_source_blob_io{id, parent, buffer_size, func}
+  , _compression{compression}
   , _compress{
       main_context().compressor(),
       _compress_handler(),
-      default_data_compression_method()} {}
+      default_data_compression_method()}
+  , _run_length{_compress_handler()} {}
 //------------------------------------------------------------------------------
 void compressed_buffer_source_blob_io::compress(
   const memory::const_block blk) noexcept {
-    _compress.next(blk, data_compression_level::highest);
+    if(_compression.run_length) {
+        _run_length.next(blk);
+    } else if(_compression.is_none()) {
+        this->append(blk);
+    } else {
+        _compress.next(blk, _compression.level);
+    }
 }
 //------------------------------------------------------------------------------
 void compressed_buffer_source_blob_io::compress(const string_view str) noexcept {
@@ -149,7 +193,11 @@ void compressed_buffer_source_blob_io::compress(const byte byt) noexcept {
 }
 //------------------------------------------------------------------------------
 void compressed_buffer_source_blob_io::finish() noexcept {
-    _compress.finish();
+    if(_compression.run_length) {
+        _run_length.finish();
+    } else if(not _compression.is_none()) {
+        _compress.finish();
+    }
 }
 //------------------------------------------------------------------------------
 // gl_rendered_source_blob_io
@@ -186,15 +234,21 @@ auto gl_rendered_source_blob_io::context_attribs(
            (EGL.context_opengl_robust_access | true);
 }
 //------------------------------------------------------------------------------
-auto gl_rendered_source_blob_io::_create_context() noexcept
+auto gl_rendered_source_blob_io::_create_context(
+  const gl_rendered_blob_params& params) noexcept
   -> shared_holder<gl_rendered_blob_context> {
+    if(params.contexts) {
+        if(auto context{params.contexts->acquire(params)}) {
+            return context;
+        }
+    }
     if(auto context{egl_context_handler::create_context(
          _shared,
-         _params,
+         params,
          config_attribs(_shared),
          surface_attribs(_shared),
          context_attribs(_shared))}) {
-        return {default_selector, *this, _shared, _params, std::move(context)};
+        return {default_selector, *this, _shared, params, std::move(context)};
     }
     return {};
 }
@@ -205,50 +259,157 @@ gl_rendered_source_blob_io::gl_rendered_source_blob_io(
   const shared_provider_objects& shared,
   const gl_rendered_blob_params& params,
   span_size_t buffer_size) noexcept
-  : compressed_buffer_source_blob_io{id, parent, buffer_size}
+  : compressed_buffer_source_blob_io{
+      id,
+      parent,
+      buffer_size,
+      params.compression}
   , _shared{shared}
   , _params{params} {}
 //------------------------------------------------------------------------------
 static bool gl_renderer_active{false};
 //------------------------------------------------------------------------------
 gl_rendered_source_blob_io::~gl_rendered_source_blob_io() noexcept {
-    if(_renderer) {
-        _renderer.reset();
-        gl_renderer_active = false;
+    _release_renderers();
+}
+//------------------------------------------------------------------------------
+void gl_rendered_source_blob_io::compress_part(
+  span_size_t part,
+  const memory::const_block data) noexcept {
+    if(part != _next_part) {
+        try {
+            _staged_parts[part].assign(data.begin(), data.end());
+        } catch(...) {
+            log_error("failed to keep rendered blob part").arg("part", part);
+        }
+        return;
+    }
+    compress(data);
+    ++_next_part;
+    for(auto pos{_staged_parts.find(_next_part)}; pos != _staged_parts.end();
+        pos = _staged_parts.find(_next_part)) {
+        compress(view(pos->second));
+        _staged_parts.erase(pos);
+        ++_next_part;
     }
 }
 //------------------------------------------------------------------------------
+// The parts of the blob are split evenly among the contexts, which are created
+// on consecutive devices, if a device index is specified.
+auto gl_rendered_source_blob_io::_create_renderers() -> bool {
+    const auto part_count{render_part_count()};
+    const auto context_count{
+      std::clamp(_params.context_count.value_or(1), 1, part_count)};
+
+    std::vector<context_renderer> renderers;
+    for(const auto index : integer_range(context_count)) {
+        auto params{_params};
+        if(params.device_index) {
+            params.device_index = *params.device_index + index;
+        }
+        if(auto context{_create_context(params)}) {
+            renderers.push_back({.params = params, .context = context});
+        } else if(renderers.empty()) {
+            return false;
+        }
+    }
+
+    const auto count{int(renderers.size())};
+    for(const auto index : integer_range(count)) {
+        auto& entry{renderers[std_size(index)]};
+        entry.params.context_count = count;
+        entry.params.first_part = (index * part_count) / count;
+        entry.params.end_part = ((index + 1) * part_count) / count;
+        entry.context->make_current();
+        entry.renderer = make_renderer(entry.params, entry.context);
+    }
+    if(count > 1) {
+        log_info("rendering blob using ${count} GL contexts")
+          .arg("count", count);
+    }
+    _renderers = std::move(renderers);
+    return true;
+}
+//------------------------------------------------------------------------------
+auto gl_rendered_source_blob_io::_render() noexcept
+  -> msgbus::blob_preparation_result {
+    float progress{0.F};
+    bool finished{true};
+    for(auto& entry : _renderers) {
+        if(not entry.finished) {
+            // other renderers or the context pool may have switched contexts
+            entry.context->make_current();
+            const auto rendering{entry.renderer->render()};
+            if(rendering.status() == msgbus::blob_preparation_status::failed) {
+                return rendering;
+            }
+            entry.finished = rendering.has_finished();
+            entry.progress = entry.finished ? 1.F : rendering.progress();
+        }
+        progress += entry.progress;
+        finished = finished and entry.finished;
+    }
+    if(finished) {
+        return msgbus::blob_preparation_result::finished();
+    }
+    return {
+      progress / float(_renderers.size()),
+      msgbus::blob_preparation_status::working};
+}
+//------------------------------------------------------------------------------
+void gl_rendered_source_blob_io::_release_renderers() noexcept {
+    if(_renderers.empty()) {
+        return;
+    }
+    for(auto& entry : _renderers) {
+        if(entry.renderer) {
+            entry.context->make_current();
+            entry.renderer.reset();
+        }
+        if(entry.context and entry.params.contexts) {
+            entry.params.contexts->release(
+              entry.params, std::move(entry.context));
+        }
+    }
+    _renderers.clear();
+    gl_renderer_active = false;
+}
+//------------------------------------------------------------------------------
 auto gl_rendered_source_blob_io::prepare() noexcept
   -> msgbus::blob_preparation_result {
     if(not _finished) {
         const auto progress_split{0.1F};
         const auto loading{load_resources()};
+        if(loading.status() == msgbus::blob_preparation_status::failed) {
+            return loading;
+        }
         if(not loading.has_finished()) {
             return {
               progress_split * loading.progress(),
               msgbus::blob_preparation_status::working};
         }
-        if(not _renderer) {
+        if(_renderers.empty()) {
             if(not gl_renderer_active) {
-                if(auto context{_create_context()}) {
-                    try {
-                        _renderer = make_renderer(std::move(context));
-                        gl_renderer_active = true;
-                    } catch(...) {
-                        return {msgbus::blob_preparation_status::failed};
-                    }
+                try {
+                    gl_renderer_active = _create_renderers();
+                } catch(...) {
+                    _release_renderers();
+                    return {msgbus::blob_preparation_status::failed};
                 }
             }
-            if(not _renderer) {
+            if(_renderers.empty()) {
                 return {
                   progress_split, msgbus::blob_preparation_status::working};
             }
         }
-        const auto rendering{_renderer->render()};
+        const auto rendering{_render()};
+        if(rendering.status() == msgbus::blob_preparation_status::failed) {
+            _release_renderers();
+            return rendering;
+        }
         if(rendering.has_finished()) {
             finish();
-            _renderer.reset();
-            gl_renderer_active = false;
+            _release_renderers();
             _finished = true;
             return {1.F, msgbus::blob_preparation_status::working};
         }
@@ -276,6 +437,109 @@ auto ostream_io::fetch_fragment(span_size_t offs, memory::block dst) noexcept
     return copy(head(src, dst), dst).size();
 }
 //------------------------------------------------------------------------------
+// shared_file
+//------------------------------------------------------------------------------
+shared_file::shared_file(
+  const std::filesystem::path& path,
+  span_size_t size,
+  std::filesystem::file_time_type modified,
+  bool map) noexcept
+  : _path{path}
+  , _size{size}
+  , _modified{modified} {
+#if EAGINE_APP_HAS_PREAD
+    _fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+#if EAGINE_APP_HAS_MMAP
+    if(map and (_fd >= 0) and (_size > 0)) {
+        _addr =
+          ::mmap(nullptr, std_size(_size), PROT_READ, MAP_SHARED, _fd, 0);
+        if(_addr == MAP_FAILED) {
+            // fragments are read with pread instead
+            _addr = nullptr;
+        }
+    }
+#else
+    (void)map;
+#endif
+#if defined(POSIX_FADV_SEQUENTIAL)
+    if((_fd >= 0) and not _addr) {
+        ::posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+#else
+    (void)map;
+#endif
+}
+//------------------------------------------------------------------------------
+auto shared_file::is_open() const noexcept -> bool {
+#if EAGINE_APP_HAS_PREAD
+    return _fd >= 0;
+#else
+    std::error_code error;
+    return std::filesystem::is_regular_file(_path, error);
+#endif
+}
+//------------------------------------------------------------------------------
+shared_file::~shared_file() noexcept {
+#if EAGINE_APP_HAS_MMAP
+    if(_addr) {
+        ::munmap(_addr, std_size(_size));
+    }
+#endif
+#if EAGINE_APP_HAS_PREAD
+    if(_fd >= 0) {
+        ::close(_fd);
+    }
+#endif
+}
+//------------------------------------------------------------------------------
+auto shared_file::mapped() const noexcept -> memory::const_block {
+    if(_addr) {
+        return {static_cast<const byte*>(_addr), _size};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+// Loose files can be rewritten or truncated while they are being served, so
+// they are read with pread and a shortened file just yields a short read.
+// Only files that are not modified in place, like packed archives, should
+// be mapped, since touching truncated mapped pages raises SIGBUS.
+auto shared_file::read(span_size_t offs, memory::block dst) noexcept
+  -> span_size_t {
+    if((offs < 0) or (offs >= _size)) {
+        return 0;
+    }
+    dst = head(dst, _size - offs);
+    if(const auto src{mapped()}; not src.empty()) {
+        return copy(head(skip(src, offs), dst.size()), dst).size();
+    }
+#if EAGINE_APP_HAS_PREAD
+    span_size_t done{0};
+    while((_fd >= 0) and (done < dst.size())) {
+        const auto got{::pread(
+          _fd,
+          dst.data() + done,
+          std_size(dst.size() - done),
+          static_cast<::off_t>(offs + done))};
+        if(got < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if(got == 0) {
+            break;
+        }
+        done += span_size(got);
+    }
+    return done;
+#else
+    std::ifstream file{_path, std::ios::in | std::ios::binary};
+    file.seekg(offs, std::ios::beg);
+    return limit_cast<span_size_t>(read_from_stream(file, dst).gcount());
+#endif
+}
+//------------------------------------------------------------------------------
 // eagitex_provider_base
 //------------------------------------------------------------------------------
 eagitex_provider_base::eagitex_provider_base(
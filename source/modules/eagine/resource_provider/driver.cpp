@@ -11,6 +11,8 @@ import eagine.core;
 import eagine.msgbus;
 import eagine.app;
 import std;
+import :blob_cache;
+import :prepare_pool;
 
 namespace eagine::app {
 //------------------------------------------------------------------------------
@@ -33,11 +35,73 @@ export struct resource_provider_interface
 
     virtual void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept = 0;
+
+    // Providers generating the same content for the same locator can have
+    // the produced blobs cached by the driver.
+    virtual auto is_blob_cacheable(const url&) noexcept -> bool {
+        return false;
+    }
+
+    // Added to the keys of the cached blobs, must change whenever the content
+    // generated for the same locator changes (generator version, settings).
+    virtual auto blob_cache_salt(const url&) noexcept -> std::string {
+        return {};
+    }
+
+    // Returns the locator from which the key of the cached blob is made,
+    // providers should spell out defaulted arguments and their aliases so
+    // that locators producing the same content share the cached blob.
+    virtual auto blob_cache_locator(const url& locator) noexcept -> url {
+        return locator;
+    }
+
+    // Pinned blobs are never evicted from the cache, neither from the memory
+    // nor from the disk, used for content that cannot be re-generated.
+    virtual auto is_blob_pinned(const url&) noexcept -> bool {
+        return false;
+    }
+
+    // Providers listing no paths or schemes are consulted for any locator.
+    virtual void for_each_served_path(
+      callable_ref<void(string_view) noexcept>) noexcept {}
+
+    virtual void for_each_served_scheme(
+      callable_ref<void(string_view) noexcept>) noexcept {}
+};
+//------------------------------------------------------------------------------
+/// @brief Method and level of compression of generated blob data.
+struct blob_compression {
+    data_compression_method method{data_compression_method::zlib};
+    data_compression_level level{data_compression_level::highest};
+    /// @brief Use the fast run-length encoding instead of the method.
+    bool run_length{false};
+
+    auto is_none() const noexcept -> bool {
+        return (method == data_compression_method::none) and not run_length;
+    }
+
+    /// @brief Returns the data_filter value for the headers of the blobs.
+    auto data_filter() const noexcept -> string_view {
+        return run_length ? "rle" : is_none() ? "none" : "zlib";
+    }
 };
+
+/// @brief Returns the compression requested by the compress argument of the
+/// locator or configured for the specified provider.
+auto get_blob_compression(
+  main_ctx_object& provider,
+  string_view provider_name,
+  const url& locator) noexcept -> blob_compression;
+
+/// @brief Returns the blob cache salt for a generator version and compression.
+auto blob_cache_salt(
+  string_view generator_version,
+  const blob_compression& compression) noexcept -> std::string;
 //------------------------------------------------------------------------------
 struct shared_provider_objects {
     external_apis& apis;
     resource_provider_driver& driver;
+    blob_prepare_pool& workers;
     old_resource_loader& old_loader;
     resource_loader& loader;
 };
@@ -77,9 +141,28 @@ public:
 private:
     void _add(unique_holder<resource_provider_interface>);
     void _populate();
+    void _build_dispatch_table();
+
+    auto _find_provider_index(const url&) noexcept -> span_size_t;
+
+    using provider_indices = std::vector<span_size_t>;
 
+    blob_prepare_pool _workers{as_parent()};
     shared_provider_objects _shared;
+    generated_blob_cache _blob_cache{as_parent(), _workers};
     std::vector<unique_holder<resource_provider_interface>> _providers;
+    provider_indices _any_providers;
+    std::map<std::string, provider_indices, std::less<>> _path_providers;
+    std::map<std::string, provider_indices, std::less<>> _scheme_providers;
+    provider_indices _candidates;
+
+    struct recent_lookup {
+        std::string locator;
+        span_size_t index{-1};
+        std::chrono::steady_clock::time_point when;
+    };
+    std::array<recent_lookup, 16> _recent_lookups;
+    std::size_t _next_recent{0U};
 };
 //------------------------------------------------------------------------------
 } // namespace eagine::app
@@ -34,6 +34,61 @@ auto resource_provider_interface::get_blob_priority(
     return increased(priority);
 }
 //------------------------------------------------------------------------------
+// blob_compression
+//------------------------------------------------------------------------------
+static auto blob_compression_from_string(string_view name) noexcept
+  -> std::optional<blob_compression> {
+    if(name == string_view{"none"}) {
+        return {
+          {.method = data_compression_method::none,
+           .level = data_compression_level::none}};
+    } else if(name == string_view{"fast"}) {
+        return {
+          {.method = data_compression_method::none,
+           .level = data_compression_level::none,
+           .run_length = true}};
+    } else if(name == string_view{"default"}) {
+        return {{.level = data_compression_level::normal}};
+    } else if(name == string_view{"best"}) {
+        return {{.level = data_compression_level::highest}};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+auto get_blob_compression(
+  main_ctx_object& provider,
+  string_view provider_name,
+  const url& locator) noexcept -> blob_compression {
+    if(const auto arg{locator.query().arg_value("compress")}) {
+        if(const auto requested{blob_compression_from_string(*arg)}) {
+            return *requested;
+        }
+    }
+    const std::string provider_key{
+      "application.resource_provider.compression." + to_string(provider_name)};
+    for(const string_view key :
+        {string_view{provider_key},
+         string_view{"application.resource_provider.compression.default"}}) {
+        if(const auto name{provider.app_config().get<std::string>(key)}) {
+            if(const auto configured{blob_compression_from_string(*name)}) {
+                return *configured;
+            }
+        }
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+auto blob_cache_salt(
+  string_view generator_version,
+  const blob_compression& compression) noexcept -> std::string {
+    return std::format(
+      "{};{}:{}:{}",
+      std::string_view{generator_version},
+      std::to_underlying(compression.method),
+      std::to_underlying(compression.level),
+      compression.run_length);
+}
+//------------------------------------------------------------------------------
 // resource_provider_driver
 //------------------------------------------------------------------------------
 void resource_provider_driver::_add(
@@ -61,6 +116,7 @@ void resource_provider_driver::_populate() {
     _add(provider_eagitex_cubemap_sky(parameters));
     _add(provider_eagitexi_cubemap_blur(parameters));
     _add(provider_eagitex_cubemap_levels_blur(parameters));
+    _add(provider_eagitex_cubemap_blur_level(parameters));
     _add(provider_eagiaudi_ogg_clip(parameters));
     _add(provider_shape(parameters));
     _add(provider_json_sky_parameters(parameters));
@@ -71,6 +127,44 @@ void resource_provider_driver::_populate() {
     _add(provider_text_resource_list(parameters));
 }
 //------------------------------------------------------------------------------
+static inline auto provider_dispatch_path(std::string_view path) noexcept
+  -> std::string_view {
+    while(path.starts_with('/')) {
+        path.remove_prefix(1);
+    }
+    return path;
+}
+//------------------------------------------------------------------------------
+void resource_provider_driver::_build_dispatch_table() {
+    for(const auto index : integer_range(provider_count())) {
+        auto& prov{provider(index)};
+        bool has_keys{false};
+
+        const auto add_path{[&](string_view path) noexcept {
+            _path_providers[std::string{provider_dispatch_path(path)}]
+              .push_back(index);
+            has_keys = true;
+        }};
+        prov.for_each_served_path({construct_from, add_path});
+
+        if(not has_keys) {
+            const auto add_scheme{[&](string_view scheme) noexcept {
+                _scheme_providers[to_string(scheme)].push_back(index);
+                has_keys = true;
+            }};
+            prov.for_each_served_scheme({construct_from, add_scheme});
+        }
+
+        if(not has_keys) {
+            _any_providers.push_back(index);
+        }
+    }
+    log_info("built resource provider dispatch table")
+      .arg("paths", span_size(_path_providers.size()))
+      .arg("schemes", span_size(_scheme_providers.size()))
+      .arg("any", span_size(_any_providers.size()));
+}
+//------------------------------------------------------------------------------
 resource_provider_driver::resource_provider_driver(
   main_ctx_parent parent,
   external_apis& apis,
@@ -80,18 +174,65 @@ resource_provider_driver::resource_provider_driver(
   , _shared{
       .apis = apis,
       .driver = *this,
+      .workers = _workers,
       .old_loader = old_loader,
       .loader = loader} {
     _populate();
+    _build_dispatch_table();
+}
+//------------------------------------------------------------------------------
+auto resource_provider_driver::_find_provider_index(const url& locator) noexcept
+  -> span_size_t {
+    _candidates.clear();
+    _candidates.insert(
+      _candidates.end(), _any_providers.begin(), _any_providers.end());
+
+    const auto add_candidates{[&](const auto& table, std::string_view key) {
+        if(const auto pos{table.find(key)}; pos != table.end()) {
+            _candidates.insert(
+              _candidates.end(), pos->second.begin(), pos->second.end());
+        }
+    }};
+    if(const auto path{locator.path_str()}) {
+        add_candidates(
+          _path_providers, provider_dispatch_path(std::string_view{*path}));
+    }
+    if(const auto scheme{locator.scheme()}) {
+        add_candidates(_scheme_providers, std::string_view{*scheme});
+    }
+    // keep the order in which the providers were registered
+    std::sort(_candidates.begin(), _candidates.end());
+
+    for(const auto index : _candidates) {
+        if(provider(index).has_resource(locator)) {
+            return index;
+        }
+    }
+    return -1;
 }
 //------------------------------------------------------------------------------
 auto resource_provider_driver::find_provider_of(const url& locator) noexcept
   -> optional_reference<resource_provider_interface> {
-    for(const auto& provider : _providers) {
-        if(provider->has_resource(locator)) {
-            return provider;
+    const std::string_view key{locator.str()};
+    const auto now{std::chrono::steady_clock::now()};
+    const std::chrono::seconds max_age{5};
+
+    for(const auto& recent : _recent_lookups) {
+        if(
+          (recent.index >= 0) and (now - recent.when < max_age) and
+          (recent.locator == key)) {
+            return provider(recent.index);
         }
     }
+
+    if(const auto index{_find_provider_index(locator)}; index >= 0) {
+        auto& recent{_recent_lookups[_next_recent]};
+        _next_recent = (_next_recent + 1U) % _recent_lookups.size();
+        recent.locator.assign(key);
+        recent.index = index;
+        recent.when = now;
+        return provider(index);
+    }
     return {};
 }
 //------------------------------------------------------------------------------
@@ -107,6 +248,19 @@ auto resource_provider_driver::get_resource_io(
   const endpoint_id_t,
   const url& locator) -> shared_holder<msgbus::source_blob_io> {
     if(const auto provider{find_provider_of(locator)}) {
+        if(provider->is_blob_cacheable(locator)) {
+            auto key{generated_blob_cache::normalized_key(
+              provider->blob_cache_locator(locator))};
+            // the normalized key has no fragment
+            key.push_back('#');
+            key.append(provider->blob_cache_salt(locator));
+            const bool pinned{provider->is_blob_pinned(locator)};
+            if(auto cached{_blob_cache.find_io(key, pinned)}) {
+                return cached;
+            }
+            return _blob_cache.wrap_io(
+              std::move(key), provider->get_resource_io(locator), pinned);
+        }
         return provider->get_resource_io(locator);
     }
     return {};
@@ -39,6 +39,20 @@ struct checks_r8_pixel_provider : pixel_provider_interface {
         return ((c.x % 2 + c.y % 2 + c.z % 2) % 2 == 0) ? 0x00U : 0xFFU;
     }
 
+    void fill_row(
+      pixel_provider_coordinate c,
+      int channels,
+      memory::block row) noexcept final {
+        assert(channels == 1);
+        const auto parity{(c.y / size) % 2 + (c.z / size) % 2};
+        auto pos{row.begin()};
+        for(int x = 0; x < c.width; x += size) {
+            const auto len{std::min(size, c.width - x)};
+            const bool black{((x / size) % 2 + parity) % 2 == 0};
+            pos = std::fill_n(pos, len, black ? byte(0x00U) : byte(0xFFU));
+        }
+    }
+
     int size;
 };
 //------------------------------------------------------------------------------
@@ -64,7 +78,7 @@ struct checks_r8_pixel_provider_factory : pixel_provider_factory_interface {
 auto provider_eagitexi_2d_checks_r8(const provider_parameters& p)
   -> unique_holder<resource_provider_interface> {
     return provider_eagitexi_2d_r8(
-      p.parent, "/2d_checks_r8", {hold<checks_r8_pixel_provider_factory>});
+      p, "/2d_checks_r8", {hold<checks_r8_pixel_provider_factory>});
 }
 //------------------------------------------------------------------------------
 } // namespace eagine::app
@@ -21,6 +21,267 @@ import std;
 
 namespace eagine::app {
 //------------------------------------------------------------------------------
+// source image
+//------------------------------------------------------------------------------
+// Loads the level 0 image of a cube-map texture into client memory, either
+// from the data embedded in the texture or from the referenced image.
+class cubemap_source_image_loader
+  : public main_ctx_object
+  , public valtree::object_builder_impl<cubemap_source_image_loader> {
+public:
+    cubemap_source_image_loader(main_ctx_parent parent) noexcept
+      : main_ctx_object{"CmSrcLoadr", parent} {}
+
+    auto is_done() const noexcept -> bool {
+        return _done;
+    }
+
+    auto has_failed() const noexcept -> bool {
+        return not _success;
+    }
+
+    auto image_locator() const noexcept -> const std::string& {
+        return _image_loc;
+    }
+
+    auto has_pixels() const noexcept -> bool;
+
+    auto side() const noexcept -> int {
+        return _width.value_or(0);
+    }
+
+    auto channels() const noexcept -> int {
+        return _channels.value_or(0);
+    }
+
+    auto pixels() const noexcept -> memory::const_block {
+        return view(_data);
+    }
+
+    auto max_token_size() noexcept -> span_size_t final {
+        return 256;
+    }
+
+    template <std::integral T>
+    void do_add(
+      const basic_string_path& path,
+      const span<const T> data) noexcept;
+
+    void do_add(
+      const basic_string_path& path,
+      span<const string_view> data) noexcept;
+
+    template <typename T>
+    void do_add(const basic_string_path&, const span<const T>) noexcept {}
+
+    void add_object(const basic_string_path& path) noexcept final;
+
+    void finish_object(const basic_string_path& path) noexcept final;
+
+    void unparsed_data(span<const memory::const_block> data) noexcept final;
+
+    auto finish() noexcept -> bool final;
+
+    void failed() noexcept final;
+
+private:
+    auto _append_data(const memory::const_block) noexcept -> bool;
+    auto _init_decompression(const string_view filter) noexcept -> bool;
+
+    memory::buffer _data;
+    stream_data_decoding _decompression;
+    std::string _image_loc;
+    std::string _cur_image_loc;
+    int _cur_image_level{0};
+    valid_if_positive<int> _width;
+    valid_if_positive<int> _height;
+    valid_if_positive<int> _channels;
+    bool _done{false};
+    bool _success{true};
+};
+//------------------------------------------------------------------------------
+auto cubemap_source_image_loader::has_pixels() const noexcept -> bool {
+    if(_width and _height and _channels) {
+        return (_width == _height) and (channels() >= 3) and
+               (channels() <= 4) and
+               (_data.size() == span_size(side() * side() * 6 * channels()));
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+auto cubemap_source_image_loader::_append_data(
+  const memory::const_block blk) noexcept -> bool {
+    memory::append_to(blk, _data);
+    return true;
+}
+//------------------------------------------------------------------------------
+auto cubemap_source_image_loader::_init_decompression(
+  const string_view filter) noexcept -> bool {
+    return _decompression.init(
+      filter,
+      main_context().buffers(),
+      make_callable_ref<&cubemap_source_image_loader::_append_data>(this));
+}
+//------------------------------------------------------------------------------
+template <std::integral T>
+void cubemap_source_image_loader::do_add(
+  const basic_string_path& path,
+  const span<const T> data) noexcept {
+    if(data.has_single_value()) {
+        if(path.has_size(1)) {
+            if(path.starts_with("width")) {
+                _success = assign_if_fits(data, _width) and _success;
+            } else if(path.starts_with("height")) {
+                _success = assign_if_fits(data, _height) and _success;
+            } else if(path.starts_with("channels")) {
+                _success = assign_if_fits(data, _channels) and _success;
+            }
+        } else if(path.has_size(3)) {
+            if(path.starts_with("images") and path.ends_with("level")) {
+                _success = assign_if_fits(data, _cur_image_level) and _success;
+            }
+        }
+    }
+}
+//------------------------------------------------------------------------------
+void cubemap_source_image_loader::do_add(
+  const basic_string_path& path,
+  span<const string_view> data) noexcept {
+    if(data.has_single_value()) {
+        if(path.has_size(1)) {
+            if(path.starts_with("data_type")) {
+                if(*data != string_view{"unsigned_byte"}) {
+                    log_error("unsupported cube-map data type ${type}")
+                      .arg("type", *data);
+                    _success = false;
+                }
+            } else if(path.starts_with("data_filter")) {
+                if(not _init_decompression(*data)) {
+                    log_error("unsupported cube-map data filter ${filter}")
+                      .arg("filter", *data);
+                    _success = false;
+                }
+            }
+        } else if(path.has_size(3)) {
+            if(path.starts_with("images") and path.ends_with("url")) {
+                _cur_image_loc = to_string(*data);
+            }
+        }
+    }
+}
+//------------------------------------------------------------------------------
+void cubemap_source_image_loader::add_object(
+  const basic_string_path& path) noexcept {
+    if(path.has_size(2) and path.starts_with("images")) {
+        _cur_image_loc.clear();
+        _cur_image_level = 0;
+    }
+}
+//------------------------------------------------------------------------------
+void cubemap_source_image_loader::finish_object(
+  const basic_string_path& path) noexcept {
+    if(path.has_size(2) and path.starts_with("images")) {
+        if(_image_loc.empty() and (_cur_image_level == 0)) {
+            _image_loc = std::move(_cur_image_loc);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+void cubemap_source_image_loader::unparsed_data(
+  span<const memory::const_block> data) noexcept {
+    if(not _decompression.is_initialized()) {
+        _init_decompression(string_view{"none"});
+    }
+    if(_success) {
+        for(const auto& blk : data) {
+            _decompression.next(blk);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+auto cubemap_source_image_loader::finish() noexcept -> bool {
+    if(_success and _decompression.is_initialized()) {
+        _success = _decompression.finish();
+    }
+    _done = true;
+    return _success;
+}
+//------------------------------------------------------------------------------
+void cubemap_source_image_loader::failed() noexcept {
+    _success = false;
+    _done = true;
+}
+//------------------------------------------------------------------------------
+// Requests the source cube-map texture and then its level 0 image if the
+// texture does not have embedded data.
+class cubemap_source_request : public main_ctx_object {
+public:
+    cubemap_source_request(
+      main_ctx_parent parent,
+      const shared_provider_objects& shared,
+      url source) noexcept
+      : main_ctx_object{"CmSrcReqst", parent}
+      , _shared{shared}
+      , _source{std::move(source)} {}
+
+    auto load() noexcept -> msgbus::blob_preparation_result;
+
+    auto image() const noexcept -> const cubemap_source_image_loader& {
+        assert(_loader);
+        return *_loader;
+    }
+
+private:
+    auto _request(const url&) noexcept -> bool;
+
+    const shared_provider_objects& _shared;
+    const url _source;
+    std::shared_ptr<cubemap_source_image_loader> _loader;
+    bool _loading_image{false};
+};
+//------------------------------------------------------------------------------
+auto cubemap_source_request::_request(const url& locator) noexcept -> bool {
+    try {
+        _loader = std::make_shared<cubemap_source_image_loader>(as_parent());
+        shared_holder<valtree::object_builder> builder{_loader};
+        const auto max_token_size{builder->max_token_size()};
+        return bool(_shared.old_loader.request_json_traversal(
+          {.locator = locator, .max_time = std::chrono::minutes{5}},
+          valtree::make_building_value_tree_visitor(std::move(builder)),
+          max_token_size));
+    } catch(...) {
+        return false;
+    }
+}
+//------------------------------------------------------------------------------
+auto cubemap_source_request::load() noexcept
+  -> msgbus::blob_preparation_result {
+    if(not _loader) {
+        if(_request(_source)) {
+            return {msgbus::blob_preparation_status::working};
+        }
+        return {msgbus::blob_preparation_status::failed};
+    }
+    if(not _loader->is_done()) {
+        return {msgbus::blob_preparation_status::working};
+    }
+    if(_loader->has_failed()) {
+        return {msgbus::blob_preparation_status::failed};
+    }
+    if(_loader->has_pixels()) {
+        return msgbus::blob_preparation_result::finished();
+    }
+    if(not _loading_image and not _loader->image_locator().empty()) {
+        _loading_image = true;
+        if(_request(url{_loader->image_locator()})) {
+            return {msgbus::blob_preparation_status::working};
+        }
+    }
+    log_error("failed to load cube-map ${source} for blurring")
+      .arg("source", _source.str());
+    return {msgbus::blob_preparation_status::failed};
+}
+//------------------------------------------------------------------------------
 // Renderer
 //------------------------------------------------------------------------------
 class eagitexi_cubemap_blur_renderer_base : public eagitexi_cubemap_renderer {
@@ -59,8 +320,11 @@ public:
       const gl_rendered_blob_params& params,
       shared_holder<gl_rendered_blob_context> context,
       url source,
+      std::shared_ptr<const cubemap_source_request> chained,
       int size,
-      int sharpness) noexcept;
+      int sample_side,
+      float sharpness,
+      int window_radius) noexcept;
 
     ~eagitexi_cubemap_blur_renderer() noexcept final;
 
@@ -69,11 +333,18 @@ public:
 private:
     static auto _vs_source() noexcept -> string_view;
     static auto _fs_source() noexcept -> string_view;
-    auto _build_program(const gl_rendered_blob_params&, int) noexcept
-      -> oglplus::program_object;
+    auto _build_program() noexcept -> oglplus::program_object;
+    auto _use_program(
+      int sample_side,
+      float sharpness,
+      int window_radius) noexcept -> oglplus::program_name;
     void _on_tex_loaded(const gl_texture_resource::load_info&) noexcept;
+    auto _make_chained_tex() noexcept -> oglplus::texture_object;
 
     gl_texture_resource _cubemap;
+    // the previous level in the level chain, already loaded by the I/O
+    const std::shared_ptr<const cubemap_source_request> _chained;
+    std::optional<oglplus::texture_object> _chained_tex;
 
     const signal_binding _sig_binding{
       _cubemap.loaded.bind_to<&eagitexi_cubemap_blur_renderer::_on_tex_loaded>(
@@ -85,39 +356,53 @@ eagitexi_cubemap_blur_renderer::eagitexi_cubemap_blur_renderer(
   const gl_rendered_blob_params& params,
   shared_holder<gl_rendered_blob_context> context,
   url source,
+  std::shared_ptr<const cubemap_source_request> chained,
   int size,
-  int sharpness) noexcept
+  int sample_side,
+  float sharpness,
+  int window_radius) noexcept
   : eagitexi_cubemap_blur_renderer_base{parent, params, std::move(context), size}
-  , _cubemap{std::move(source), resource_context()} {
-    _init_program(_build_program(params, sharpness));
+  , _cubemap{std::move(source), resource_context()}
+  , _chained{std::move(chained)} {
+    _init_program(_use_program(sample_side, sharpness, window_radius));
 }
 //------------------------------------------------------------------------------
 eagitexi_cubemap_blur_renderer::~eagitexi_cubemap_blur_renderer() noexcept {
     _cubemap.clean_up(resource_context());
 }
 //------------------------------------------------------------------------------
-auto eagitexi_cubemap_blur_renderer::_build_program(
-  const gl_rendered_blob_params& params,
-  int sharpness) noexcept -> oglplus::program_object {
+auto eagitexi_cubemap_blur_renderer::_build_program() noexcept
+  -> oglplus::program_object {
     const auto& glapi{gl_api()};
     const auto& [gl, GL]{glapi};
 
-    // program
     auto prog{glapi.create_program_object()};
     glapi.add_shader(prog, GL.vertex_shader, embedded<"iCmBlurVS">());
     glapi.add_shader(prog, GL.fragment_shader, embedded<"iCmBlurFS">());
     gl.link_program(prog);
-    gl.use_program(prog);
-
     gl.bind_attrib_location(prog, _screen_position_loc(), "Position");
-    glapi.try_set_uniform(
-      prog,
-      "cubeSide",
-      std::min(
-        std::max(params.surface_width.value(), params.surface_height.value()),
-        128));
+
+    return prog;
+}
+//------------------------------------------------------------------------------
+// The program is linked only once per GL context and reused by the renderers
+// of subsequent blobs, only the uniforms are set for each of them.
+auto eagitexi_cubemap_blur_renderer::_use_program(
+  int sample_side,
+  float sharpness,
+  int window_radius) noexcept -> oglplus::program_name {
+    const auto& glapi{gl_api()};
+    const auto& gl{glapi.operations()};
+
+    const auto build{[this]() noexcept {
+        return _build_program();
+    }};
+    const auto prog{program("iCmBlur", {construct_from, build})};
+    gl.use_program(prog);
+    glapi.try_set_uniform(prog, "cubeSide", sample_side);
 
     glapi.try_set_uniform(prog, "sharpness", sharpness);
+    glapi.try_set_uniform(prog, "windowRadius", window_radius);
     glapi.try_set_uniform(prog, "cubeMap", 0);
 
     return prog;
@@ -132,8 +417,74 @@ void eagitexi_cubemap_blur_renderer::_on_tex_loaded(
     loaded.parameter_i(GL.texture_wrap_t, GL.clamp_to_edge);
 }
 //------------------------------------------------------------------------------
+// The previous level of a level chain is rendered by the renderers of this
+// provider, so it cannot be loaded as a GL texture while this renderer holds
+// the GL rendering slot and it is uploaded from the pixels loaded by the I/O.
+auto eagitexi_cubemap_blur_renderer::_make_chained_tex() noexcept
+  -> oglplus::texture_object {
+    const auto& glapi{gl_api()};
+    const auto& [gl, GL]{glapi};
+    const auto& image{_chained->image()};
+    const auto side{image.side()};
+    const auto format{image.channels() == 3 ? GL.rgb : GL.rgba};
+    const auto iformat{image.channels() == 3 ? GL.rgb8 : GL.rgba8};
+    const auto face_size{span_size(side * side * image.channels())};
+    const std::array<oglplus::texture_target, 6> faces{
+      {GL.texture_cube_map_positive_x,
+       GL.texture_cube_map_negative_x,
+       GL.texture_cube_map_positive_y,
+       GL.texture_cube_map_negative_y,
+       GL.texture_cube_map_positive_z,
+       GL.texture_cube_map_negative_z}};
+
+    auto tex{glapi.create_texture_object(GL.texture_cube_map)};
+    gl.active_texture(GL.texture0);
+    gl.bind_texture(GL.texture_cube_map, tex);
+    if(glapi.tex_storage2d) {
+        gl.tex_storage2d(GL.texture_cube_map, 1, iformat, side, side);
+    }
+    for(const auto f : integer_range(6)) {
+        const auto data{head(skip(image.pixels(), face_size * f), face_size)};
+        if(glapi.tex_storage2d) {
+            gl.tex_sub_image2d(
+              faces[std_size(f)],
+              0,
+              0,
+              0,
+              side,
+              side,
+              format,
+              GL.unsigned_byte_,
+              data);
+        } else {
+            gl.tex_image2d(
+              faces[std_size(f)],
+              0,
+              iformat,
+              side,
+              side,
+              0, // border
+              format,
+              GL.unsigned_byte_,
+              data);
+        }
+    }
+    const auto target{GL.texture_cube_map};
+    gl.tex_parameter_i(target, GL.texture_min_filter, GL.linear);
+    gl.tex_parameter_i(target, GL.texture_mag_filter, GL.linear);
+    gl.tex_parameter_i(target, GL.texture_wrap_s, GL.clamp_to_edge);
+    gl.tex_parameter_i(target, GL.texture_wrap_t, GL.clamp_to_edge);
+    return tex;
+}
+//------------------------------------------------------------------------------
 auto eagitexi_cubemap_blur_renderer::prepare_render() noexcept
   -> msgbus::blob_preparation_result {
+    if(_chained) {
+        if(not _chained_tex) {
+            _chained_tex.emplace(_make_chained_tex());
+        }
+        return msgbus::blob_preparation_result::finished();
+    }
     const auto& GL{gl_api().constants()};
     if(_cubemap.load_if_needed(
          resource_context(), GL.texture_cube_map, GL.texture0)) {
@@ -142,6 +493,123 @@ auto eagitexi_cubemap_blur_renderer::prepare_render() noexcept
     return msgbus::blob_preparation_result::finished();
 }
 //------------------------------------------------------------------------------
+// level chain
+//------------------------------------------------------------------------------
+// The sharpness of the blur of the individual levels of a blurred cube-map
+// relative to the original, not blurred source image.
+static auto cubemap_blur_level_sharpness(int level) noexcept -> float {
+    switch(level) {
+        case 1:
+            return 20.F;
+        case 2:
+            return 16.F;
+        case 3:
+            return 8.F;
+        case 4:
+            return 4.F;
+        case 5:
+            return 2.F;
+        case 6:
+            return 1.F;
+        default:
+            break;
+    }
+    return 0.F;
+}
+//------------------------------------------------------------------------------
+// In the level chain each level is blurred from the previous level and not
+// from the source image. The angular variance of the blur kernel is roughly
+// inversely proportional to its exponent and the variances of consecutive
+// blurs add up, so this returns the sharpness of the kernel that blurs
+// the previous level into the current one.
+static auto cubemap_blur_chain_sharpness(int level) noexcept -> float {
+    const float max_sharpness{cubemap_blur_level_sharpness(1)};
+    if(level <= 1) {
+        return max_sharpness;
+    }
+    const auto prev{std::exp2(cubemap_blur_level_sharpness(level - 1))};
+    const auto curr{std::exp2(cubemap_blur_level_sharpness(level))};
+    if(prev <= curr) {
+        // only downsampling of the previous level is needed
+        return max_sharpness;
+    }
+    return std::min(std::log2(prev * curr / (prev - curr)), max_sharpness);
+}
+//------------------------------------------------------------------------------
+// Samples with weights below this fraction of the maximum are ignored.
+static constexpr const float cubemap_blur_min_weight{1e-6F};
+//------------------------------------------------------------------------------
+// Returns the radius (in texels of a grid with the specified side) of the
+// window around each blurred texel, outside of which all weights of the kernel
+// with the specified sharpness are negligible. Returns zero if sampling
+// the whole cube-map with full_side is cheaper or if the window could not be
+// sampled on the plane of a single face. The radius is estimated for texels
+// in the corners of the faces, where the plane is the most stretched.
+static auto cubemap_blur_window_radius(
+  int sample_side,
+  int full_side,
+  float sharpness) noexcept -> int {
+    const auto max_angle{std::acos(std::exp(
+      std::log(cubemap_blur_min_weight) / std::exp2(std::max(sharpness, 0.F))))};
+    if(not(max_angle < 0.6F)) {
+        return 0;
+    }
+    const float corner_angle{std::atan(std::sqrt(2.F))};
+    const auto plane_radius{
+      std::tan(corner_angle + max_angle) - std::tan(corner_angle)};
+    const auto radius{
+      int(std::ceil(plane_radius * float(sample_side) * 0.5F))};
+    const auto window_taps{(2 * radius + 1) * (2 * radius + 1)};
+    if(window_taps >= 6 * full_side * full_side) {
+        return 0;
+    }
+    return std::max(radius, 1);
+}
+//------------------------------------------------------------------------------
+static auto cubemap_blur_chain_image_url(
+  const url& source,
+  int level,
+  int size) -> std::string {
+    return std::format(
+      "eagitexi:///cube_map_blur?source={}&level={}&size={}&chain=true",
+      url::encode_component(source.get_string()),
+      level,
+      size);
+}
+//------------------------------------------------------------------------------
+static auto cubemap_blur_chain_level_url(
+  const url& source,
+  int level,
+  int size) -> std::string {
+    return std::format(
+      "eagitex:///cube_map_blur_level?source={}&level={}&size={}",
+      url::encode_component(source.get_string()),
+      level,
+      size);
+}
+//------------------------------------------------------------------------------
+// The beginning of the header of the blurred cube-map image, which is the same
+// regardless of how the image is rendered.
+static auto cubemap_blur_header_bgn(
+  int size,
+  std::optional<int> level,
+  string_view data_filter) -> std::string {
+    std::stringstream hdr;
+    hdr << R"({"width":)" << size;
+    if(level) {
+        hdr << R"(,"level":)" << *level;
+    }
+    hdr << R"(,"height":)" << size;
+    hdr << R"(,"depth":)" << 6;
+    hdr << R"(,"channels":4)";
+    hdr << R"(,"data_type":"unsigned_byte")";
+    hdr << R"(,"format":"rgba")";
+    hdr << R"(,"iformat":"rgba8")";
+    hdr << R"(,"tag":["blur","cubemap"])";
+    hdr << R"(,"data_filter":")" << data_filter << '"';
+    return hdr.str();
+}
+//------------------------------------------------------------------------------
 // I/O
 //------------------------------------------------------------------------------
 class eagitexi_cubemap_blur_io final : public gl_rendered_source_blob_io {
@@ -152,37 +620,33 @@ public:
       const gl_rendered_blob_params& params,
       url source,
       int size,
-      int sharpness,
-      int level) noexcept;
+      int sample_side,
+      float sharpness,
+      int window_radius,
+      std::optional<int> level,
+      bool chained) noexcept;
 
 protected:
-    auto make_renderer(shared_holder<gl_rendered_blob_context>) noexcept
+    auto load_resources() noexcept -> msgbus::blob_preparation_result final;
+    auto render_part_count() const noexcept -> int final {
+        return 6;
+    }
+    auto make_renderer(
+      const gl_rendered_blob_params&,
+      shared_holder<gl_rendered_blob_context>) noexcept
       -> unique_holder<gl_blob_renderer> final;
 
 private:
-    void _make_header_bgn(int size, int level) noexcept;
     void _make_header_end(eagitexi_cubemap_blur_renderer&) noexcept;
 
     const url _source;
     const int _size;
-    const int _sharpness;
+    const int _sample_side;
+    const float _sharpness;
+    const int _window_radius;
+    std::shared_ptr<cubemap_source_request> _chained;
 };
 //------------------------------------------------------------------------------
-void eagitexi_cubemap_blur_io::_make_header_bgn(int size, int level) noexcept {
-    std::stringstream hdr;
-    hdr << R"({"level":)" << level;
-    hdr << R"(,"width":)" << size;
-    hdr << R"(,"height":)" << size;
-    hdr << R"(,"depth":)" << 6;
-    hdr << R"(,"channels":4)";
-    hdr << R"(,"data_type":"unsigned_byte")";
-    hdr << R"(,"format":"rgba")";
-    hdr << R"(,"iformat":"rgba8")";
-    hdr << R"(,"tag":["blur","cubemap"])";
-    hdr << R"(,"data_filter":"zlib")";
-    append(hdr.str());
-}
-//------------------------------------------------------------------------------
 void eagitexi_cubemap_blur_io::_make_header_end(
   eagitexi_cubemap_blur_renderer& renderer) noexcept {
     std::stringstream hdr;
@@ -211,33 +675,625 @@ eagitexi_cubemap_blur_io::eagitexi_cubemap_blur_io(
   const gl_rendered_blob_params& params,
   url source,
   int size,
-  int sharpness,
-  int level) noexcept
+  int sample_side,
+  float sharpness,
+  int window_radius,
+  std::optional<int> level,
+  bool chained) noexcept
   : gl_rendered_source_blob_io{"ITxCubBlur", parent, shared, params, size * size * 6}
   , _source{std::move(source)}
   , _size{size}
-  , _sharpness{sharpness} {
-    _make_header_bgn(size, level);
+  , _sample_side{sample_side}
+  , _sharpness{sharpness}
+  , _window_radius{window_radius} {
+    append(cubemap_blur_header_bgn(size, level, data_filter()));
+    if(chained) {
+        _chained = std::make_shared<cubemap_source_request>(
+          as_parent(), shared, _source);
+    }
+}
+//------------------------------------------------------------------------------
+// The previous level of a level chain is generated by this provider and needs
+// the GL rendering slot, so it must be loaded before the renderers are created.
+auto eagitexi_cubemap_blur_io::load_resources() noexcept
+  -> msgbus::blob_preparation_result {
+    if(_chained) {
+        return _chained->load();
+    }
+    return msgbus::blob_preparation_result::finished();
 }
 //------------------------------------------------------------------------------
 auto eagitexi_cubemap_blur_io::make_renderer(
+  const gl_rendered_blob_params& params,
   shared_holder<gl_rendered_blob_context> context) noexcept
   -> unique_holder<gl_blob_renderer> {
     unique_holder<eagitexi_cubemap_blur_renderer> renderer{
       default_selector,
       *this,
-      params(),
+      params,
       std::move(context),
       _source,
+      _chained,
       _size,
-      _sharpness};
+      _sample_side,
+      _sharpness,
+      _window_radius};
 
     assert(renderer);
-    _make_header_end(*renderer);
+    // the header is finished only once, by the renderer of the first faces
+    if(params.first_part == 0) {
+        _make_header_end(*renderer);
+    }
 
     return renderer;
 }
 //------------------------------------------------------------------------------
+// software renderer
+//------------------------------------------------------------------------------
+// Axes of the cube-map faces, the same as in the blur fragment shader.
+struct cubemap_face_axes {
+    std::array<float, 3> u;
+    std::array<float, 3> v;
+    std::array<float, 3> n;
+
+    auto direction(float fu, float fv) const noexcept -> std::array<float, 3> {
+        std::array<float, 3> result{};
+        float len{0.F};
+        for(std::size_t c = 0U; c < 3U; ++c) {
+            result[c] = u[c] * fu + v[c] * fv + n[c];
+            len += result[c] * result[c];
+        }
+        len = std::sqrt(len);
+        for(auto& c : result) {
+            c /= len;
+        }
+        return result;
+    }
+};
+//------------------------------------------------------------------------------
+static constexpr const std::array<cubemap_face_axes, 6> cubemap_faces{
+  {{{0.F, 0.F, -1.F}, {0.F, -1.F, 0.F}, {1.F, 0.F, 0.F}},
+   {{0.F, 0.F, 1.F}, {0.F, -1.F, 0.F}, {-1.F, 0.F, 0.F}},
+   {{1.F, 0.F, 0.F}, {0.F, 0.F, 1.F}, {0.F, 1.F, 0.F}},
+   {{1.F, 0.F, 0.F}, {0.F, 0.F, -1.F}, {0.F, -1.F, 0.F}},
+   {{1.F, 0.F, 0.F}, {0.F, -1.F, 0.F}, {0.F, 0.F, 1.F}},
+   {{-1.F, 0.F, 0.F}, {0.F, -1.F, 0.F}, {0.F, 0.F, -1.F}}}};
+//------------------------------------------------------------------------------
+// State shared by the software blur I/O and by the work items computing
+// the rows of the blurred cube-map faces in the blob preparation workers.
+// The samples of the source are stored as separate arrays of components,
+// so that the loops over them can be vectorized by the compiler.
+class cubemap_blur_cpu_job {
+public:
+    cubemap_blur_cpu_job(
+      const cubemap_source_image_loader& source,
+      int size,
+      int sample_side,
+      float sharpness,
+      int window_radius);
+
+    auto row_count() const noexcept -> int {
+        return _size * 6;
+    }
+
+    auto done_rows() const noexcept -> int {
+        return _done_rows.load();
+    }
+
+    auto is_done() const noexcept -> bool {
+        return done_rows() == row_count();
+    }
+
+    auto face(int f) const noexcept -> memory::const_block {
+        const auto face_size{span_size(_size * _size * 4)};
+        return head(skip(view(_pixels), face_size * f), face_size);
+    }
+
+    /// @brief Computes rows until the deadline, returns false if none are left.
+    auto work(std::chrono::steady_clock::time_point deadline) noexcept -> bool;
+
+    void cancel() noexcept {
+        _cancelled = true;
+    }
+
+private:
+    void _sample_source(const cubemap_source_image_loader&);
+    void _copy_source(const cubemap_source_image_loader&);
+    auto _sample(const std::array<float, 3>& dir) const noexcept
+      -> std::array<float, 4>;
+    auto _weight(float cos) const noexcept -> float;
+    void _blur_row(int row, std::vector<float>& weights) noexcept;
+    void _blur_row_window(int row) noexcept;
+    auto _face_weights(
+      int f,
+      const std::array<float, 3>& dir,
+      std::vector<float>& weights) const noexcept -> bool;
+
+    const int _size;
+    const int _side;
+    const int _window_radius;
+    const int _squarings;
+    const float _base_exponent;
+    float _min_cos{0.F};
+    // copy of the source, sampled directly in the window mode
+    std::vector<byte> _source;
+    int _src_side{0};
+    int _src_channels{0};
+    std::vector<float> _nx;
+    std::vector<float> _ny;
+    std::vector<float> _nz;
+    std::array<std::vector<float>, 4> _colors;
+    std::vector<byte> _pixels;
+    std::atomic<int> _next_row{0};
+    std::atomic<int> _done_rows{0};
+    std::atomic<bool> _cancelled{false};
+};
+//------------------------------------------------------------------------------
+// The weight exponent 2^sharpness is applied as the fractional part followed
+// by repeated squaring, which is exact for integral sharpness values.
+cubemap_blur_cpu_job::cubemap_blur_cpu_job(
+  const cubemap_source_image_loader& source,
+  int size,
+  int sample_side,
+  float sharpness,
+  int window_radius)
+  : _size{size}
+  , _side{std::max(sample_side, 2)}
+  , _window_radius{window_radius}
+  , _squarings{int(std::floor(std::max(sharpness, 0.F)))}
+  , _base_exponent{std::exp2(std::max(sharpness, 0.F) - float(_squarings))} {
+    _min_cos =
+      std::exp(std::log(cubemap_blur_min_weight) / std::exp2(sharpness));
+    _pixels.resize(std_size(_size * _size * 6 * 4));
+    if(_window_radius > 0) {
+        _copy_source(source);
+    } else {
+        _sample_source(source);
+    }
+}
+//------------------------------------------------------------------------------
+void cubemap_blur_cpu_job::_copy_source(
+  const cubemap_source_image_loader& source) {
+    const auto pixels{source.pixels()};
+    _source.assign(pixels.begin(), pixels.end());
+    _src_side = source.side();
+    _src_channels = source.channels();
+}
+//------------------------------------------------------------------------------
+// Samples the copy of the source with bilinear filtering and edge clamping
+// in the same way as _sample_source, on the face the direction points to.
+auto cubemap_blur_cpu_job::_sample(const std::array<float, 3>& dir)
+  const noexcept -> std::array<float, 4> {
+    const auto dot{[](const auto& a, const auto& b) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }};
+    std::size_t f{0U};
+    float max_cos{-2.F};
+    for(std::size_t i = 0U; i < cubemap_faces.size(); ++i) {
+        if(const auto cos{dot(dir, cubemap_faces[i].n)}; max_cos < cos) {
+            max_cos = cos;
+            f = i;
+        }
+    }
+    const auto& axes{cubemap_faces[f]};
+    const auto s{(dot(dir, axes.u) / max_cos + 1.F) * 0.5F};
+    const auto t{(dot(dir, axes.v) / max_cos + 1.F) * 0.5F};
+
+    const auto texel{[&](int x, int y, int c) {
+        if(c >= _src_channels) {
+            return 1.F;
+        }
+        x = std::clamp(x, 0, _src_side - 1);
+        y = std::clamp(y, 0, _src_side - 1);
+        const auto offs{
+          ((int(f) * _src_side + y) * _src_side + x) * _src_channels + c};
+        return float(_source[std_size(offs)]) / 255.F;
+    }};
+    const auto fx{s * float(_src_side) - 0.5F};
+    const auto fy{t * float(_src_side) - 0.5F};
+    const auto x0{int(std::floor(fx))};
+    const auto y0{int(std::floor(fy))};
+    const auto tx{fx - float(x0)};
+    const auto ty{fy - float(y0)};
+    std::array<float, 4> result{};
+    for(const auto c : integer_range(4)) {
+        result[std_size(c)] = std::lerp(
+          std::lerp(texel(x0, y0, c), texel(x0 + 1, y0, c), tx),
+          std::lerp(texel(x0, y0 + 1, c), texel(x0 + 1, y0 + 1, c), tx),
+          ty);
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+auto cubemap_blur_cpu_job::_weight(float cos) const noexcept -> float {
+    auto w{std::max(cos, 0.F)};
+    if(_base_exponent != 1.F) {
+        w = std::pow(w, _base_exponent);
+    }
+    for(int k = 0; k < _squarings; ++k) {
+        w *= w;
+    }
+    return w;
+}
+//------------------------------------------------------------------------------
+// Blurs a row from the texels in the window around each blurred texel,
+// sampled on the plane of its face, extended past the edges, and weighted
+// by their solid angle like in the blur fragment shader.
+void cubemap_blur_cpu_job::_blur_row_window(int row) noexcept {
+    const auto f{row / _size};
+    const auto y{row % _size};
+    const auto& axes{cubemap_faces[std_size(f)]};
+    const float inv_size{1.F / float(_size)};
+    const float step{2.F / float(_side)};
+    byte* dst{_pixels.data() + std_size(row * _size * 4)};
+
+    for(const auto x : integer_range(_size)) {
+        const auto pu{float(2 * x + 1) * inv_size - 1.F};
+        const auto pv{float(2 * y + 1) * inv_size - 1.F};
+        const auto dir{axes.direction(pu, pv)};
+        std::array<float, 4> accum_color{};
+        float accum_weight{0.F};
+        for(int dy = -_window_radius; dy <= _window_radius; ++dy) {
+            for(int dx = -_window_radius; dx <= _window_radius; ++dx) {
+                const auto su{pu + float(dx) * step};
+                const auto sv{pv + float(dy) * step};
+                const auto sdir{axes.direction(su, sv)};
+                const auto weight{
+                  _weight(
+                    dir[0] * sdir[0] + dir[1] * sdir[1] + dir[2] * sdir[2]) /
+                  std::pow(1.F + su * su + sv * sv, 1.5F)};
+                if(weight > 0.F) {
+                    const auto color{_sample(sdir)};
+                    for(const auto c : integer_range(4)) {
+                        accum_color[std_size(c)] +=
+                          color[std_size(c)] * weight;
+                    }
+                    accum_weight += weight;
+                }
+            }
+        }
+        if(accum_weight > 0.F) {
+            for(auto& c : accum_color) {
+                c /= accum_weight;
+            }
+        } else {
+            accum_color = _sample(dir);
+        }
+        for(const auto c : accum_color) {
+            *dst++ = byte(std::lround(std::clamp(c, 0.F, 1.F) * 255.F));
+        }
+    }
+}
+//------------------------------------------------------------------------------
+void cubemap_blur_cpu_job::_sample_source(
+  const cubemap_source_image_loader& source) {
+    const auto count{std_size(6 * _side * _side)};
+    _nx.resize(count);
+    _ny.resize(count);
+    _nz.resize(count);
+    for(auto& color : _colors) {
+        color.resize(count);
+    }
+
+    const auto src_side{source.side()};
+    const auto channels{source.channels()};
+    const auto pixels{source.pixels()};
+    const auto texel{[&](int f, int x, int y, int c) {
+        if(c >= channels) {
+            return 1.F;
+        }
+        x = std::clamp(x, 0, src_side - 1);
+        y = std::clamp(y, 0, src_side - 1);
+        const auto offs{((f * src_side + y) * src_side + x) * channels + c};
+        return float(pixels[offs]) / 255.F;
+    }};
+
+    // samples the source with bilinear filtering and edge clamping
+    const float inv_side{1.F / float(_side - 1)};
+    std::size_t i{0U};
+    for(const auto f : integer_range(6)) {
+        for(const auto y : integer_range(_side)) {
+            for(const auto x : integer_range(_side)) {
+                const auto s{float(x) * inv_side};
+                const auto t{float(y) * inv_side};
+                const auto dir{cubemap_faces[std_size(f)].direction(
+                  s * 2.F - 1.F, t * 2.F - 1.F)};
+                _nx[i] = dir[0];
+                _ny[i] = dir[1];
+                _nz[i] = dir[2];
+
+                const auto fx{s * float(src_side) - 0.5F};
+                const auto fy{t * float(src_side) - 0.5F};
+                const auto x0{int(std::floor(fx))};
+                const auto y0{int(std::floor(fy))};
+                const auto tx{fx - float(x0)};
+                const auto ty{fy - float(y0)};
+                for(const auto c : integer_range(4)) {
+                    const auto y1{y0 + 1};
+                    const auto x1{x0 + 1};
+                    _colors[std_size(c)][i] = std::lerp(
+                      std::lerp(texel(f, x0, y0, c), texel(f, x1, y0, c), tx),
+                      std::lerp(texel(f, x0, y1, c), texel(f, x1, y1, c), tx),
+                      ty);
+                }
+                ++i;
+            }
+        }
+    }
+}
+//------------------------------------------------------------------------------
+auto cubemap_blur_cpu_job::_face_weights(
+  int f,
+  const std::array<float, 3>& dir,
+  std::vector<float>& weights) const noexcept -> bool {
+    // no point on a face is farther from its center than this angle
+    const float max_face_angle{std::acos(1.F / std::sqrt(3.F))};
+    const auto& axes{cubemap_faces[std_size(f)]};
+    const auto center_cos{
+      dir[0] * axes.n[0] + dir[1] * axes.n[1] + dir[2] * axes.n[2]};
+    const auto min_angle{std::acos(std::clamp(center_cos, -1.F, 1.F))};
+    if(std::cos(std::max(min_angle - max_face_angle, 0.F)) < _min_cos) {
+        return false;
+    }
+
+    const auto count{std_size(_side * _side)};
+    const auto offs{std_size(f) * count};
+    const float* nx{_nx.data() + offs};
+    const float* ny{_ny.data() + offs};
+    const float* nz{_nz.data() + offs};
+    float* w{weights.data()};
+    for(std::size_t i = 0U; i < count; ++i) {
+        w[i] =
+          std::max(dir[0] * nx[i] + dir[1] * ny[i] + dir[2] * nz[i], 0.F);
+    }
+    if(_base_exponent != 1.F) {
+        for(std::size_t i = 0U; i < count; ++i) {
+            w[i] = std::pow(w[i], _base_exponent);
+        }
+    }
+    for(int k = 0; k < _squarings; ++k) {
+        for(std::size_t i = 0U; i < count; ++i) {
+            w[i] *= w[i];
+        }
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+void cubemap_blur_cpu_job::_blur_row(
+  int row,
+  std::vector<float>& weights) noexcept {
+    const auto f{row / _size};
+    const auto y{row % _size};
+    const auto count{std_size(_side * _side)};
+    const auto& axes{cubemap_faces[std_size(f)]};
+    const float inv_size{1.F / float(_size)};
+    byte* dst{_pixels.data() + std_size(row * _size * 4)};
+
+    for(const auto x : integer_range(_size)) {
+        const auto dir{axes.direction(
+          float(2 * x + 1) * inv_size - 1.F,
+          float(2 * y + 1) * inv_size - 1.F)};
+        std::array<float, 4> accum_color{};
+        float accum_weight{0.F};
+        for(const auto sf : integer_range(6)) {
+            if(not _face_weights(sf, dir, weights)) {
+                continue;
+            }
+            const auto offs{std_size(sf) * count};
+            const auto bgn{weights.begin()};
+            const auto end{bgn + std::ptrdiff_t(count)};
+            accum_weight += std::reduce(std::execution::unseq, bgn, end, 0.F);
+            for(const auto c : integer_range(4)) {
+                accum_color[std_size(c)] += std::transform_reduce(
+                  std::execution::unseq,
+                  bgn,
+                  end,
+                  _colors[std_size(c)].begin() + std::ptrdiff_t(offs),
+                  0.F);
+            }
+        }
+        if(accum_weight > 0.F) {
+            for(auto& c : accum_color) {
+                c /= accum_weight;
+            }
+        } else {
+            // all weights underflowed, use the closest sample
+            std::size_t closest{0U};
+            float max_cos{-2.F};
+            for(std::size_t i = 0U; i < _nx.size(); ++i) {
+                const auto cos{
+                  dir[0] * _nx[i] + dir[1] * _ny[i] + dir[2] * _nz[i]};
+                if(max_cos < cos) {
+                    max_cos = cos;
+                    closest = i;
+                }
+            }
+            for(const auto c : integer_range(4)) {
+                accum_color[std_size(c)] = _colors[std_size(c)][closest];
+            }
+        }
+        for(const auto c : accum_color) {
+            *dst++ = byte(std::lround(std::clamp(c, 0.F, 1.F) * 255.F));
+        }
+    }
+}
+//------------------------------------------------------------------------------
+auto cubemap_blur_cpu_job::work(
+  std::chrono::steady_clock::time_point deadline) noexcept -> bool {
+    std::vector<float> weights;
+    try {
+        if(_window_radius == 0) {
+            weights.resize(std_size(_side * _side));
+        }
+    } catch(...) {
+        return false;
+    }
+    while(not _cancelled) {
+        const auto row{_next_row.fetch_add(1)};
+        if(row >= row_count()) {
+            break;
+        }
+        if(_window_radius > 0) {
+            _blur_row_window(row);
+        } else {
+            _blur_row(row, weights);
+        }
+        _done_rows.fetch_add(1);
+        if(std::chrono::steady_clock::now() >= deadline) {
+            return true;
+        }
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+// Each work item blurs the rows for a single time slice and then puts itself
+// at the end of the queue, so that other blobs are prepared in between.
+static void enqueue_cubemap_blur_slice(
+  blob_prepare_pool& workers,
+  std::shared_ptr<cubemap_blur_cpu_job> job) {
+    workers.enqueue(
+      [&workers, job{std::move(job)}](const std::stop_token& stop) {
+          const auto slice{std::chrono::milliseconds{100}};
+          while(not stop.stop_requested() and
+                job->work(std::chrono::steady_clock::now() + slice)) {
+              try {
+                  enqueue_cubemap_blur_slice(workers, job);
+                  return;
+              } catch(...) {
+                  // keep working in this item if it cannot be re-enqueued
+              }
+          }
+      });
+}
+//------------------------------------------------------------------------------
+// Blurs the cube-map in client memory on the threads of the blob preparation
+// pool, when there is no GL device or when forced by the configuration.
+// The output is the same as that of eagitexi_cubemap_blur_io.
+class eagitexi_cubemap_blur_cpu_io final
+  : public compressed_buffer_source_blob_io {
+public:
+    eagitexi_cubemap_blur_cpu_io(
+      main_ctx_parent,
+      const shared_provider_objects& shared,
+      const blob_compression& compression,
+      url source,
+      int size,
+      int sample_side,
+      float sharpness,
+      int window_radius,
+      std::optional<int> level) noexcept;
+
+    eagitexi_cubemap_blur_cpu_io(eagitexi_cubemap_blur_cpu_io&&) = delete;
+    eagitexi_cubemap_blur_cpu_io(const eagitexi_cubemap_blur_cpu_io&) = delete;
+    auto operator=(eagitexi_cubemap_blur_cpu_io&&) = delete;
+    auto operator=(const eagitexi_cubemap_blur_cpu_io&) = delete;
+
+    ~eagitexi_cubemap_blur_cpu_io() noexcept final {
+        if(_job) {
+            _job->cancel();
+        }
+    }
+
+    auto prepare() noexcept -> msgbus::blob_preparation_result final;
+
+private:
+    void _start_job();
+
+    const shared_provider_objects& _shared;
+    const url _source;
+    const int _size;
+    const int _sample_side;
+    const float _sharpness;
+    const int _window_radius;
+    std::optional<cubemap_source_request> _source_request;
+    std::shared_ptr<cubemap_blur_cpu_job> _job;
+    bool _finished{false};
+};
+//------------------------------------------------------------------------------
+eagitexi_cubemap_blur_cpu_io::eagitexi_cubemap_blur_cpu_io(
+  main_ctx_parent parent,
+  const shared_provider_objects& shared,
+  const blob_compression& compression,
+  url source,
+  int size,
+  int sample_side,
+  float sharpness,
+  int window_radius,
+  std::optional<int> level) noexcept
+  : compressed_buffer_source_blob_io{
+      "ITxCbBlCPU",
+      parent,
+      size * size * 6,
+      compression}
+  , _shared{shared}
+  , _source{std::move(source)}
+  , _size{size}
+  , _sample_side{sample_side}
+  , _sharpness{sharpness}
+  , _window_radius{window_radius} {
+    append(cubemap_blur_header_bgn(size, level, data_filter()));
+    append("}");
+    _source_request.emplace(as_parent(), shared, _source);
+}
+//------------------------------------------------------------------------------
+void eagitexi_cubemap_blur_cpu_io::_start_job() {
+    _job = std::make_shared<cubemap_blur_cpu_job>(
+      _source_request->image(),
+      _size,
+      _sample_side,
+      _sharpness,
+      _window_radius);
+    _source_request.reset();
+
+    const auto item_count{std::min(
+      _shared.workers.worker_count(), span_size(_job->row_count()))};
+    for(span_size_t i = 0; i < item_count; ++i) {
+        enqueue_cubemap_blur_slice(_shared.workers, _job);
+    }
+    log_info("blurring cube-map in software")
+      .arg("source", _source.str())
+      .arg("size", _size)
+      .arg("workers", item_count);
+}
+//------------------------------------------------------------------------------
+auto eagitexi_cubemap_blur_cpu_io::prepare() noexcept
+  -> msgbus::blob_preparation_result {
+    if(_finished) {
+        return msgbus::blob_preparation_result::finished();
+    }
+    const auto progress_split{0.1F};
+    if(not _job) {
+        const auto loading{_source_request->load()};
+        if(not loading.has_finished()) {
+            return loading;
+        }
+        try {
+            _start_job();
+        } catch(...) {
+            return {msgbus::blob_preparation_status::failed};
+        }
+    }
+    if(not _shared.workers.has_workers()) {
+        // without workers the rows are blurred in time slices here
+        _job->work(
+          std::chrono::steady_clock::now() + std::chrono::milliseconds{10});
+    }
+    if(not _job->is_done()) {
+        return {
+          progress_split + (1.F - progress_split) *
+                             float(_job->done_rows()) /
+                             float(_job->row_count()),
+          msgbus::blob_preparation_status::working};
+    }
+    for(const auto f : integer_range(6)) {
+        compress(_job->face(f));
+    }
+    finish();
+    _job.reset();
+    _finished = true;
+    return {1.F, msgbus::blob_preparation_status::working};
+}
+//------------------------------------------------------------------------------
 // provider
 //------------------------------------------------------------------------------
 class eagitexi_cubemap_blur_provider final
@@ -257,16 +1313,45 @@ public:
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
 
+    auto is_blob_cacheable(const url&) noexcept -> bool final {
+        return true;
+    }
+
+    // bump the version when the blur shader or the parameters change
+    auto blob_cache_salt(const url& locator) noexcept -> std::string final {
+        return app::blob_cache_salt(
+          "blur3", get_blob_compression(*this, "cubemap_blur", locator));
+    }
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("cube_map_blur");
+    }
+
 private:
+    auto _use_cpu(const gl_rendered_blob_params&) noexcept -> bool;
+
     const shared_provider_objects& _shared;
     application_config_value<int> _device_index{
       main_context().config(),
       "application.resource_provider.cubemap_blur.device_index",
       -1};
+    application_config_value<bool> _force_cpu{
+      main_context().config(),
+      "application.resource_provider.cubemap_blur.force_cpu",
+      false};
+    std::optional<bool> _has_gl_display;
     application_config_value<std::chrono::seconds> _blob_timeout{
       main_context().config(),
       "application.resource_provider.cubemap_blur.blob_timeout",
       std::chrono::seconds{900}};
+    application_config_value<int> _context_count{
+      main_context().config(),
+      "application.resource_provider.cubemap_blur.render_contexts",
+      1};
+    shared_holder<gl_rendered_blob_context_pool> _contexts{
+      default_selector,
+      as_parent()};
 };
 //------------------------------------------------------------------------------
 eagitexi_cubemap_blur_provider::eagitexi_cubemap_blur_provider(
@@ -284,31 +1369,87 @@ auto eagitexi_cubemap_blur_provider::has_resource(const url& locator) noexcept
     return false;
 }
 //------------------------------------------------------------------------------
+auto eagitexi_cubemap_blur_provider::_use_cpu(
+  const gl_rendered_blob_params& params) noexcept -> bool {
+    if(_force_cpu.value()) {
+        return true;
+    }
+    if(not _has_gl_display) {
+        _has_gl_display = egl_context_handler::has_display(_shared, params);
+        if(not *_has_gl_display) {
+            log_info("no GL display available, cube-maps are blurred on CPU");
+        }
+    }
+    return not *_has_gl_display;
+}
+//------------------------------------------------------------------------------
 auto eagitexi_cubemap_blur_provider::get_resource_io(const url& locator)
   -> shared_holder<msgbus::source_blob_io> {
     if(has_resource(locator)) {
         const auto& q{locator.query()};
         const auto size{q.arg_value_as<int>("size").value_or(1024)};
-        const auto sharpness{q.arg_value_as<int>("sharpness").value_or(8)};
         const auto level{q.arg_value_as<int>("level").value_or(0)};
+        url source{q.arg_url("source")};
+        auto sharpness{q.arg_value_as<float>("sharpness").value_or(8.F)};
+        const auto full_side{std::min(size, 128)};
+        std::optional<int> header_level{level};
+        bool chained{false};
+
+        if(q.arg_has_value("chain", true) and (level > 0)) {
+            // blur the previous level instead of the source image, the image
+            // level is specified by the texture referencing this image
+            sharpness = cubemap_blur_chain_sharpness(level);
+            header_level.reset();
+            if(level > 1) {
+                source = url{
+                  cubemap_blur_chain_level_url(source, level - 1, size * 2)};
+                chained = true;
+            }
+        }
+        // sharp kernels sample only a window of texels of a grid with
+        // the resolution of the previous level, others the whole cube-map
+        const auto window_radius{
+          cubemap_blur_window_radius(size * 2, full_side, sharpness)};
+        const auto sample_side{window_radius > 0 ? size * 2 : full_side};
 
         gl_rendered_blob_params params{
           .device_index = _device_index.value(),
           .surface_width = size,
-          .surface_height = size};
+          .surface_height = size,
+          .compression = get_blob_compression(*this, "cubemap_blur", locator),
+          .contexts = _contexts,
+          .context_count = _context_count.value()};
 
         q.arg_value_as<int>("device_index")
           .and_then(_1.assign_to(params.device_index));
+        q.arg_value_as<int>("render_contexts")
+          .and_then(_1.assign_to(params.context_count));
 
+        if(_use_cpu(params)) {
+            return {
+              hold<eagitexi_cubemap_blur_cpu_io>,
+              as_parent(),
+              _shared,
+              params.compression,
+              std::move(source),
+              size,
+              sample_side,
+              sharpness,
+              window_radius,
+              header_level};
+        }
         return {
           hold<eagitexi_cubemap_blur_io>,
           as_parent(),
           _shared,
           params,
-          q.arg_url("source"),
+          std::move(source),
           size,
+          sample_side,
           sharpness,
-          level};
+          window_radius,
+          header_level,
+          chained};
     }
     return {};
 }
@@ -383,6 +1524,7 @@ private:
     shared_provider_objects& _shared;
     const url _locator;
     const url _source_loc;
+    const bool _chain;
     std::string _image_loc;
     std::string _text_content;
     flat_set<std::string> _tags;
@@ -407,7 +1549,8 @@ eagitex_cubemap_levels_blur_io::eagitex_cubemap_levels_blur_io(
   : main_ctx_object{"ITxCbLvlBl", parent}
   , _shared{shared}
   , _locator{std::move(locator)}
-  , _source_loc{_locator.query().arg_url("source")} {
+  , _source_loc{_locator.query().arg_url("source")}
+  , _chain{_locator.query().arg_has_value("chain", true)} {
     _tags.insert("generated");
     _tags.insert("cubemap");
     _tags.insert("blur");
@@ -474,34 +1617,24 @@ auto eagitex_cubemap_levels_blur_io::_make_content() const noexcept
     hdr << R"(,"images":)";
     hdr << R"([{"url":")" << _image_loc << R"("})";
 
-    const auto sharpness{[](int level, int) {
-        switch(level) {
-            case 1:
-                return 20;
-            case 2:
-                return 16;
-            case 3:
-                return 8;
-            case 4:
-                return 4;
-            case 5:
-                return 2;
-            case 6:
-                return 1;
-            default:
-                break;
-        }
-        return 0;
-    }};
-
     const std::string enc_img_loc{
       url::encode_component(_source_loc.get_string())};
     int size{_width.value()};
     for(int level = 1; level < _levels; ++level) {
         size /= 2;
-        hdr << R"(,{"url":"eagitexi:///cube_map_blur?source=)" << enc_img_loc
-            << R"(&level=)" << level << R"(&size=)" << size << R"(&sharpness=)"
-            << sharpness(level, _levels) << R"("})";
+        if(_chain) {
+            // each level is blurred from the previous one; the images
+            // do not specify their level, so that they can also serve
+            // as the single-level source texture of the next level
+            hdr << R"(,{"level":)" << level << R"(,"url":")"
+                << cubemap_blur_chain_image_url(_source_loc, level, size)
+                << R"("})";
+        } else {
+            hdr << R"(,{"url":"eagitexi:///cube_map_blur?source=)"
+                << enc_img_loc << R"(&level=)" << level << R"(&size=)" << size
+                << R"(&sharpness=)" << cubemap_blur_level_sharpness(level)
+                << R"("})";
+        }
     }
 
     hdr << "]}";
@@ -599,6 +1732,11 @@ public:
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
 
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("cube_map_levels_blur");
+    }
+
 private:
     shared_provider_objects& _shared;
 
@@ -648,8 +1786,104 @@ void eagitex_cubemap_levels_blur_provider::for_each_locator(
     callback("eagitex:///cube_map_levels_blur");
 }
 //------------------------------------------------------------------------------
+// chained blur level texture I/O
+//------------------------------------------------------------------------------
+// Single-level cube-map texture with a blurred level of the level chain,
+// used as the source for blurring of the next level.
+struct eagitex_cubemap_blur_level_io final : simple_string_source_blob_io {
+    auto make_header(const url&) -> std::string;
+
+    eagitex_cubemap_blur_level_io(main_ctx_parent parent, const url& locator);
+};
+//------------------------------------------------------------------------------
+eagitex_cubemap_blur_level_io::eagitex_cubemap_blur_level_io(
+  main_ctx_parent parent,
+  const url& locator)
+  : simple_string_source_blob_io{"ITxCbBlLvl", parent, make_header(locator)} {}
+//------------------------------------------------------------------------------
+auto eagitex_cubemap_blur_level_io::make_header(const url& locator)
+  -> std::string {
+    const auto& q{locator.query()};
+    const auto size{q.arg_value_as<int>("size").value_or(512)};
+    std::stringstream hdr;
+    hdr << R"({"levels":1)";
+    hdr << R"(,"width":)" << size;
+    hdr << R"(,"height":)" << size;
+    hdr << R"(,"channels":4)";
+    hdr << R"(,"data_type":"unsigned_byte")";
+    hdr << R"(,"format":"rgba")";
+    hdr << R"(,"iformat":"rgba8")";
+    hdr << R"(,"wrap_s":"clamp_to_edge")";
+    hdr << R"(,"wrap_t":"clamp_to_edge")";
+    hdr << R"(,"tag":["blur","cubemap","generated"])";
+    hdr << R"(,"images":[{"url":")"
+        << cubemap_blur_chain_image_url(
+             q.arg_url("source"),
+             q.arg_value_as<int>("level").value_or(1),
+             size)
+        << R"("}]})";
+    return hdr.str();
+}
+//------------------------------------------------------------------------------
+// chained blur level texture provider
+//------------------------------------------------------------------------------
+class eagitex_cubemap_blur_level_provider final
+  : public main_ctx_object
+  , public resource_provider_interface {
+public:
+    eagitex_cubemap_blur_level_provider(const provider_parameters&) noexcept;
+
+    auto has_resource(const url& locator) noexcept -> bool final;
+
+    auto get_resource_io(const url& locator)
+      -> shared_holder<msgbus::source_blob_io> final;
+
+    void for_each_locator(
+      callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("cube_map_blur_level");
+    }
+};
+//------------------------------------------------------------------------------
+eagitex_cubemap_blur_level_provider::eagitex_cubemap_blur_level_provider(
+  const provider_parameters& params) noexcept
+  : main_ctx_object{"PTxCbBlLvl", params.parent} {}
+//------------------------------------------------------------------------------
+auto eagitex_cubemap_blur_level_provider::has_resource(
+  const url& locator) noexcept -> bool {
+    if(
+      is_valid_eagitex_resource_url(locator) and
+      locator.has_path("cube_map_blur_level")) {
+        const auto& q{locator.query()};
+        return is_valid_eagitex_resource_url(q.arg_url("source")) and
+               (q.arg_value_as<int>("level").value_or(1) > 0) and
+               (q.arg_value_as<int>("size").value_or(512) > 0);
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+auto eagitex_cubemap_blur_level_provider::get_resource_io(const url& locator)
+  -> shared_holder<msgbus::source_blob_io> {
+    if(has_resource(locator)) {
+        return {hold<eagitex_cubemap_blur_level_io>, as_parent(), locator};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+void eagitex_cubemap_blur_level_provider::for_each_locator(
+  callable_ref<void(string_view) noexcept> callback) noexcept {
+    callback("eagitex:///cube_map_blur_level");
+}
+//------------------------------------------------------------------------------
 // provider factory functions
 //------------------------------------------------------------------------------
+auto provider_eagitex_cubemap_blur_level(const provider_parameters& params)
+  -> unique_holder<resource_provider_interface> {
+    return {hold<eagitex_cubemap_blur_level_provider>, params};
+}
+//------------------------------------------------------------------------------
 auto provider_eagitex_cubemap_levels_blur(const provider_parameters& params)
   -> unique_holder<resource_provider_interface> {
     return {hold<eagitex_cubemap_levels_blur_provider>, params};
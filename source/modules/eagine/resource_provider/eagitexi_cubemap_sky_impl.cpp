@@ -147,6 +147,95 @@ auto cubemap_scene::sun_xyz() const noexcept -> math::vector<float, 3> {
     return math::to_cartesian(sun_coord());
 }
 //------------------------------------------------------------------------------
+// tiling
+//------------------------------------------------------------------------------
+// The tiling is loaded and decoded once by the I/O and shared by the renderers
+// in all of its GL contexts, so that all faces of the cube-map use the same
+// clouds even if the tiling is generated randomly.
+struct cubemap_sky_tiling {
+    oglplus::gl_types::sizei_type side{0};
+    oglplus::gl_types::sizei_type rows{0};
+    std::vector<byte> data;
+    // the key of the tiling texture, set once the tiling is complete
+    std::string texture_key;
+
+    auto is_complete() const noexcept -> bool {
+        return side and (rows == side);
+    }
+
+    void process_line(const string_view);
+    void finish();
+};
+//------------------------------------------------------------------------------
+// the textures are cached by content, identical tilings share the texture
+void cubemap_sky_tiling::finish() {
+    texture_key = std::format(
+      "tiling:{}:{:016x}",
+      side,
+      std::hash<std::string_view>{}(std::string_view{
+        reinterpret_cast<const char*>(data.data()), data.size()}));
+}
+//------------------------------------------------------------------------------
+void cubemap_sky_tiling::process_line(const string_view line) {
+    if(not side) {
+        assign_if_fits(line.size(), side);
+        data.reserve(std_size(side) * std_size(side));
+    }
+    if(side and (side == line.size())) {
+        if(rows < side) {
+            for(const char c : line) {
+                const byte b{hex_char2byte(c).value_or(byte{})};
+                data.push_back(byte(b << 4U | b));
+            }
+            ++rows;
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// Decoded tilings shared by the I/Os of a provider and keyed by the tiling URL,
+// so that subsequent sky cube-maps, for example the frames of an animation,
+// do not fetch and parse the same tiling again.
+class cubemap_sky_tiling_cache {
+public:
+    auto find(const std::string& locator) noexcept
+      -> std::shared_ptr<const cubemap_sky_tiling>;
+
+    void insert(
+      const std::string& locator,
+      std::shared_ptr<const cubemap_sky_tiling>) noexcept;
+
+private:
+    static constexpr const std::size_t _max_count{4U};
+    // most recently used first
+    std::list<std::pair<std::string, std::shared_ptr<const cubemap_sky_tiling>>>
+      _entries;
+};
+//------------------------------------------------------------------------------
+auto cubemap_sky_tiling_cache::find(const std::string& locator) noexcept
+  -> std::shared_ptr<const cubemap_sky_tiling> {
+    const auto pos{std::ranges::find(
+      _entries, locator, [](const auto& entry) -> const auto& {
+          return entry.first;
+      })};
+    if(pos != _entries.end()) {
+        _entries.splice(_entries.begin(), _entries, pos);
+        return pos->second;
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+void cubemap_sky_tiling_cache::insert(
+  const std::string& locator,
+  std::shared_ptr<const cubemap_sky_tiling> tiling) noexcept {
+    try {
+        _entries.emplace_front(locator, std::move(tiling));
+        if(_entries.size() > _max_count) {
+            _entries.pop_back();
+        }
+    } catch(...) {
+    }
+}
+//------------------------------------------------------------------------------
 // Renderer
 //------------------------------------------------------------------------------
 class eagitexi_cubemap_sky_renderer_base : public eagitexi_cubemap_renderer {
@@ -196,40 +285,23 @@ public:
       const shared_provider_objects& shared,
       const gl_rendered_blob_params& params,
       const cubemap_scene& scene,
+      const cubemap_sky_tiling& tiling,
       shared_holder<gl_rendered_blob_context> context,
       int size) noexcept;
 
-    ~eagitexi_cubemap_sky_renderer() noexcept final;
-
     auto prepare_render() noexcept -> msgbus::blob_preparation_result final;
 
 private:
-    void _process_cell(byte);
-    void _process_line(const string_view);
-
-    void _line_loaded(old_resource_loader::string_list_load_info& info) noexcept;
-    void _loaded(const loaded_resource_base& info) noexcept;
-
-    auto _build_program(
+    auto _build_program() noexcept -> oglplus::program_object;
+    auto _use_program(
       const gl_rendered_blob_params&,
-      const cubemap_scene&) noexcept -> oglplus::program_object;
-    void _setup_tex_storage() noexcept;
-    void _add_tex_image_row() noexcept;
-    void _set_tex_parameters() noexcept;
+      const cubemap_scene&) noexcept -> oglplus::program_name;
+    auto _make_tiling_tex() noexcept -> oglplus::texture_object;
+    void _use_tiling_tex() noexcept;
 
-    const shared_provider_objects& _shared;
-    oglplus::gl_types::sizei_type _tiling_side{0};
-    oglplus::gl_types::int_type _tiling_yofs{0};
-    oglplus::texture_object _tiling_tex;
-    main_ctx_buffer _tiling_line;
-    string_list_resource _tiling;
-    const signal_binding _line_binding{
-      _shared.old_loader.string_line_loaded
-        .bind_to<&eagitexi_cubemap_sky_renderer::_line_loaded>(this)};
-    const signal_binding _done_binding{
-      _tiling.load_event.bind_to<&eagitexi_cubemap_sky_renderer::_loaded>(
-        this)};
-    msgbus::blob_preparation_context _prep_status;
+    const cubemap_sky_tiling& _tiling;
+    const std::string _tiling_key;
+    std::optional<gl_cached_texture> _tiling_tex;
 };
 //------------------------------------------------------------------------------
 eagitexi_cubemap_sky_renderer::eagitexi_cubemap_sky_renderer(
@@ -237,39 +309,39 @@ eagitexi_cubemap_sky_renderer::eagitexi_cubemap_sky_renderer(
   const shared_provider_objects& shared,
   const gl_rendered_blob_params& params,
   const cubemap_scene& scene,
+  const cubemap_sky_tiling& tiling,
   shared_holder<gl_rendered_blob_context> context,
   int size) noexcept
   : eagitexi_cubemap_sky_renderer_base{parent, shared, params, context, size}
-  , _tiling_tex{gl_api().create_texture_object(gl_api().texture_2d)}
-  , _shared{shared}
-  , _tiling_line{*this, 1024}
-  , _tiling{url{scene.tiling_url}, shared.old_loader} {
-    _tiling_line.clear();
-    _init_program(_build_program(params, scene));
-}
-//------------------------------------------------------------------------------
-eagitexi_cubemap_sky_renderer::~eagitexi_cubemap_sky_renderer() noexcept {
-    _tiling.clean_up(_shared.old_loader);
+  , _tiling{tiling}
+  , _tiling_key{tiling.texture_key}
+  , _tiling_tex{cached_texture(_tiling_key)} {
+    _init_program(_use_program(params, scene));
+    if(_tiling_tex) {
+        _use_tiling_tex();
+    }
 }
 //------------------------------------------------------------------------------
+// The texture is created here, where this renderer's GL context is current.
 auto eagitexi_cubemap_sky_renderer::prepare_render() noexcept
   -> msgbus::blob_preparation_result {
-    loaded_resource_context context{_shared.old_loader, _shared.loader};
-    return _prep_status(_tiling.load_if_needed(context));
+    if(not _tiling_tex) {
+        _tiling_tex = cache_texture(
+          _tiling_key, _make_tiling_tex(), _tiling.side, _tiling.side);
+        _use_tiling_tex();
+    }
+    return msgbus::blob_preparation_result::finished();
 }
 //------------------------------------------------------------------------------
-auto eagitexi_cubemap_sky_renderer::_build_program(
-  const gl_rendered_blob_params& params,
-  const cubemap_scene& scene) noexcept -> oglplus::program_object {
+auto eagitexi_cubemap_sky_renderer::_build_program() noexcept
+  -> oglplus::program_object {
     const auto& glapi{gl_api()};
     const auto& [gl, GL]{glapi};
 
-    // program
     auto prog{glapi.create_program_object()};
     glapi.add_shader(prog, GL.vertex_shader, embedded<"iCmSkyVS">());
     glapi.add_shader(prog, GL.fragment_shader, embedded<"iCmSkyFS">());
     gl.link_program(prog);
-    gl.use_program(prog);
     // TODO: remove this
     std::array<char, 1024> temp;
     if(auto info{gl.get_program_info_log(prog, cover(temp))}) {
@@ -278,6 +350,23 @@ auto eagitexi_cubemap_sky_renderer::_build_program(
 
     gl.bind_attrib_location(prog, _screen_position_loc(), "Position");
 
+    return prog;
+}
+//------------------------------------------------------------------------------
+// The program is linked only once per GL context and reused by the renderers
+// of subsequent sky cube-maps, only the scene uniforms are set for each one.
+auto eagitexi_cubemap_sky_renderer::_use_program(
+  const gl_rendered_blob_params&,
+  const cubemap_scene& scene) noexcept -> oglplus::program_name {
+    const auto& glapi{gl_api()};
+    const auto& gl{glapi.operations()};
+
+    const auto build{[this]() noexcept {
+        return _build_program();
+    }};
+    const auto prog{program("iCmSky", {construct_from, build})};
+    gl.use_program(prog);
+
     glapi.try_set_uniform(prog, "planetRadius", scene.planet_radius_m);
     glapi.try_set_uniform(prog, "atmThickness", scene.atmosphere_thickness_m);
     glapi.try_set_uniform(prog, "vaporThickness", scene.vapor_thickness_ratio);
@@ -294,117 +383,78 @@ auto eagitexi_cubemap_sky_renderer::_build_program(
     return prog;
 }
 //------------------------------------------------------------------------------
-void eagitexi_cubemap_sky_renderer::_setup_tex_storage() noexcept {
+// The whole decoded tiling is uploaded in a single call and the texture
+// is kept in the GL context, for the renderers of subsequent sky cube-maps
+// using the same tiling.
+auto eagitexi_cubemap_sky_renderer::_make_tiling_tex() noexcept
+  -> oglplus::texture_object {
     const auto& glapi{gl_api()};
     const auto& [gl, GL]{glapi};
+    auto tex{glapi.create_texture_object(GL.texture_2d)};
     gl.active_texture(GL.texture0);
-    gl.bind_texture(GL.texture_2d, _tiling_tex);
+    gl.bind_texture(GL.texture_2d, tex);
+    const auto side{_tiling.side};
     if(gl.texture_storage2d) {
-        gl.texture_storage2d(_tiling_tex, 1, GL.r8, _tiling_side, _tiling_side);
+        gl.texture_storage2d(tex, 1, GL.r8, side, side);
     } else if(glapi.tex_storage2d) {
-        gl.tex_storage2d(GL.texture_2d, 1, GL.r8, _tiling_side, _tiling_side);
+        gl.tex_storage2d(GL.texture_2d, 1, GL.r8, side, side);
     } else if(glapi.tex_image2d) {
         gl.tex_image2d(
           GL.texture_2d,
           0,
           GL.r8,
-          _tiling_side,
-          _tiling_side,
+          side,
+          side,
           0, // border
           GL.red,
           GL.unsigned_byte_,
           {});
     }
-}
-//------------------------------------------------------------------------------
-void eagitexi_cubemap_sky_renderer::_add_tex_image_row() noexcept {
-    const auto& glapi{gl_api()};
-    const auto& [gl, GL]{glapi};
     if(gl.texture_sub_image2d) {
         gl.texture_sub_image2d(
-          _tiling_tex,
+          tex,
           0,
           0,
-          _tiling_yofs,
-          _tiling_side,
-          1,
+          0,
+          side,
+          side,
           GL.red,
           GL.unsigned_byte_,
-          view(_tiling_line));
+          view(_tiling.data));
     } else if(gl.tex_sub_image2d) {
-        gl.active_texture(GL.texture0);
-        gl.bind_texture(GL.texture_2d, _tiling_tex);
         gl.tex_sub_image2d(
           GL.texture_2d,
           0,
           0,
-          _tiling_yofs,
-          _tiling_side,
-          1,
+          0,
+          side,
+          side,
           GL.red,
           GL.unsigned_byte_,
-          view(_tiling_line));
+          view(_tiling.data));
     }
-    _tiling_yofs += 1;
-}
-//------------------------------------------------------------------------------
-void eagitexi_cubemap_sky_renderer::_set_tex_parameters() noexcept {
-    const auto& glapi{gl_api()};
-    const auto& [gl, GL]{glapi};
     if(gl.texture_parameter_i) {
-        gl.texture_parameter_i(_tiling_tex, GL.texture_wrap_s, GL.repeat);
-        gl.texture_parameter_i(_tiling_tex, GL.texture_wrap_t, GL.repeat);
-        gl.texture_parameter_i(_tiling_tex, GL.texture_min_filter, GL.linear);
-        gl.texture_parameter_i(_tiling_tex, GL.texture_mag_filter, GL.linear);
+        gl.texture_parameter_i(tex, GL.texture_wrap_s, GL.repeat);
+        gl.texture_parameter_i(tex, GL.texture_wrap_t, GL.repeat);
+        gl.texture_parameter_i(tex, GL.texture_min_filter, GL.linear);
+        gl.texture_parameter_i(tex, GL.texture_mag_filter, GL.linear);
     } else if(gl.tex_parameter_i) {
         gl.tex_parameter_i(GL.texture_2d, GL.texture_wrap_s, GL.repeat);
         gl.tex_parameter_i(GL.texture_2d, GL.texture_wrap_t, GL.repeat);
         gl.tex_parameter_i(GL.texture_2d, GL.texture_min_filter, GL.linear);
         gl.tex_parameter_i(GL.texture_2d, GL.texture_mag_filter, GL.linear);
     }
-    glapi.try_set_uniform(prog(), "tilingSide", float(_tiling_side));
-    glapi.try_set_uniform(prog(), "tilingTex", GL.texture0);
-}
-//------------------------------------------------------------------------------
-void eagitexi_cubemap_sky_renderer::_process_cell(byte b) {
-    b = b << 4U | b;
-    append_to(view_one(b), _tiling_line);
-}
-//------------------------------------------------------------------------------
-void eagitexi_cubemap_sky_renderer::_process_line(const string_view line) {
-    for(const char c : line) {
-        _process_cell(hex_char2byte(c).value_or(byte{}));
-    }
-    if(not _tiling_side) {
-        if(assign_if_fits(_tiling_line.size(), _tiling_side)) {
-            _setup_tex_storage();
-        }
-    }
-    if(_tiling_side and (_tiling_side == _tiling_line.size())) {
-        if(_tiling_yofs < _tiling_side) {
-            _add_tex_image_row();
-            _tiling_line.clear();
-        }
-    }
+    return tex;
 }
 //------------------------------------------------------------------------------
-void eagitexi_cubemap_sky_renderer::_line_loaded(
-  old_resource_loader::string_list_load_info& info) noexcept {
-    if(_tiling.originated(info)) {
-        for(const auto& line : info.strings) {
-            if(not line.empty()) {
-                if(math::is_positive_power_of_2(line.size())) {
-                    _process_line(line);
-                }
-            }
-        }
-        info.strings.clear();
-    }
-}
-//------------------------------------------------------------------------------
-void eagitexi_cubemap_sky_renderer::_loaded(
-  const loaded_resource_base&) noexcept {
-    _set_tex_parameters();
+void eagitexi_cubemap_sky_renderer::_use_tiling_tex() noexcept {
+    assert(_tiling_tex);
+    const auto& glapi{gl_api()};
+    const auto& [gl, GL]{glapi};
+    gl.active_texture(GL.texture0);
+    gl.bind_texture(GL.texture_2d, _tiling_tex->name);
+    glapi.try_set_uniform(prog(), "tilingSide", float(_tiling_tex->width));
+    glapi.try_set_uniform(prog(), "tilingTex", GL.texture0);
 }
 //------------------------------------------------------------------------------
 // I/O
@@ -415,29 +465,50 @@ public:
       main_ctx_parent,
       const shared_provider_objects& shared,
       const gl_rendered_blob_params& params,
+      std::shared_ptr<cubemap_sky_tiling_cache> tilings,
       const url& locator,
       int size) noexcept;
+    eagitexi_cubemap_sky_io(eagitexi_cubemap_sky_io&&) = delete;
+    eagitexi_cubemap_sky_io(const eagitexi_cubemap_sky_io&) = delete;
+    auto operator=(eagitexi_cubemap_sky_io&&) = delete;
+    auto operator=(const eagitexi_cubemap_sky_io&) = delete;
+    ~eagitexi_cubemap_sky_io() noexcept final;
 
 protected:
     auto load_resources() noexcept -> msgbus::blob_preparation_result final;
-    auto make_renderer(shared_holder<gl_rendered_blob_context>) noexcept
+    auto render_part_count() const noexcept -> int final {
+        return 6;
+    }
+    auto make_renderer(
+      const gl_rendered_blob_params&,
+      shared_holder<gl_rendered_blob_context>) noexcept
       -> unique_holder<gl_blob_renderer> final;
 
 private:
-    void _make_header_bgn(int size) noexcept;
+    void _make_header_bgn(int size, int level) noexcept;
     void _make_header_end(eagitexi_cubemap_sky_renderer&) noexcept;
+    void _line_loaded(old_resource_loader::string_list_load_info& info) noexcept;
+    auto _load_tiling() noexcept -> msgbus::blob_preparation_result;
 
     const shared_provider_objects& _shared;
+    const std::shared_ptr<cubemap_sky_tiling_cache> _tilings;
     const url _locator;
     const int _size;
     cubemap_scene _scene{_locator};
     std::optional<resource_request_result> _scene_request{};
     resource_load_status _scene_load_status{resource_load_status::not_found};
+    // the tiling URL can come from the scene parameters
+    std::optional<string_list_resource> _tiling_resource;
+    std::shared_ptr<cubemap_sky_tiling> _loading_tiling;
+    std::shared_ptr<const cubemap_sky_tiling> _tiling;
+    const signal_binding _line_binding{
+      _shared.old_loader.string_line_loaded
+        .bind_to<&eagitexi_cubemap_sky_io::_line_loaded>(this)};
 };
 //------------------------------------------------------------------------------
-void eagitexi_cubemap_sky_io::_make_header_bgn(int size) noexcept {
+void eagitexi_cubemap_sky_io::_make_header_bgn(int size, int level) noexcept {
     std::stringstream hdr;
-    hdr << R"({"level":0)";
+    hdr << R"({"level":)" << level;
     hdr << R"(,"width":)" << size;
     hdr << R"(,"height":)" << size;
     hdr << R"(,"depth":)" << 6;
@@ -446,7 +517,7 @@ void eagitexi_cubemap_sky_io::_make_header_bgn(int size) noexcept {
     hdr << R"(,"format":"rgba")";
     hdr << R"(,"iformat":"rgba8")";
     hdr << R"(,"tag":["sky","cubemap","generated"])";
-    hdr << R"(,"data_filter":"zlib")";
+    hdr << R"(,"data_filter":")" << data_filter() << '"';
     append(hdr.str());
 }
 //------------------------------------------------------------------------------
@@ -476,10 +547,12 @@ eagitexi_cubemap_sky_io::eagitexi_cubemap_sky_io(
   main_ctx_parent parent,
   const shared_provider_objects& shared,
   const gl_rendered_blob_params& params,
+  std::shared_ptr<cubemap_sky_tiling_cache> tilings,
   const url& locator,
   int size) noexcept
   : gl_rendered_source_blob_io{"ITxSkySky", parent, shared, params, size * size * 6}
   , _shared{shared}
+  , _tilings{std::move(tilings)}
   , _locator{locator}
   , _size{size} {
     if(const auto params_url{_locator.query().arg_url("params")}) {
@@ -489,7 +562,74 @@ eagitexi_cubemap_sky_io::eagitexi_cubemap_sky_io(
     } else {
         _scene_load_status = resource_load_status::loaded;
     }
-    _make_header_bgn(size);
+    _make_header_bgn(
+      size, _locator.query().arg_value_as<int>("level").value_or(0));
+}
+//------------------------------------------------------------------------------
+eagitexi_cubemap_sky_io::~eagitexi_cubemap_sky_io() noexcept {
+    if(_tiling_resource) {
+        _tiling_resource->clean_up(_shared.old_loader);
+    }
+}
+//------------------------------------------------------------------------------
+void eagitexi_cubemap_sky_io::_line_loaded(
+  old_resource_loader::string_list_load_info& info) noexcept {
+    if(
+      _loading_tiling and _tiling_resource and
+      _tiling_resource->originated(info)) {
+        for(const auto& line : info.strings) {
+            if(not line.empty()) {
+                if(math::is_positive_power_of_2(line.size())) {
+                    _loading_tiling->process_line(line);
+                }
+            }
+        }
+        info.strings.clear();
+    }
+}
+//------------------------------------------------------------------------------
+auto eagitexi_cubemap_sky_io::_load_tiling() noexcept
+  -> msgbus::blob_preparation_result {
+    if(_tiling) {
+        return msgbus::blob_preparation_result::finished();
+    }
+    if(not _tiling_resource) {
+        if((_tiling = _tilings->find(_scene.tiling_url))) {
+            return msgbus::blob_preparation_result::finished();
+        }
+        try {
+            _loading_tiling = std::make_shared<cubemap_sky_tiling>();
+            _tiling_resource.emplace(
+              url{_scene.tiling_url}, _shared.old_loader);
+        } catch(...) {
+            return {msgbus::blob_preparation_status::failed};
+        }
+    }
+    if(_tiling_resource->is_loaded()) {
+        if(not _loading_tiling->is_complete()) {
+            log_error("invalid sky tiling data")
+              .arg("side", _loading_tiling->side)
+              .arg("rows", _loading_tiling->rows)
+              .arg("url", "URL", _scene.tiling_url);
+            return {msgbus::blob_preparation_status::failed};
+        }
+        try {
+            _loading_tiling->finish();
+        } catch(...) {
+            return {msgbus::blob_preparation_status::failed};
+        }
+        _tiling = std::move(_loading_tiling);
+        _tilings->insert(_scene.tiling_url, _tiling);
+        return msgbus::blob_preparation_result::finished();
+    }
+    if(_tiling_resource->has_failed()) {
+        log_error("failed to load sky tiling")
+          .arg("url", "URL", _scene.tiling_url);
+        return {msgbus::blob_preparation_status::failed};
+    }
+    loaded_resource_context context{_shared.old_loader, _shared.loader};
+    _tiling_resource->load_if_needed(context);
+    return {msgbus::blob_preparation_status::working};
 }
 //------------------------------------------------------------------------------
 auto eagitexi_cubemap_sky_io::load_resources() noexcept
@@ -500,23 +640,28 @@ auto eagitexi_cubemap_sky_io::load_resources() noexcept
         }
         _scene_request.reset();
     }
-    return msgbus::blob_preparation_result::finished();
+    return _load_tiling();
 }
 //------------------------------------------------------------------------------
 auto eagitexi_cubemap_sky_io::make_renderer(
+  const gl_rendered_blob_params& params,
   shared_holder<gl_rendered_blob_context> context) noexcept
   -> unique_holder<gl_blob_renderer> {
     unique_holder<eagitexi_cubemap_sky_renderer> renderer{
       default_selector,
       *this,
       _shared,
-      params(),
+      params,
       _scene,
+      *_tiling,
       std::move(context),
       _size};
 
     assert(renderer);
-    _make_header_end(*renderer);
+    // the header is finished only once, by the renderer of the first faces
+    if(params.first_part == 0) {
+        _make_header_end(*renderer);
+    }
 
     return renderer;
 }
@@ -540,6 +685,21 @@ public:
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
 
+    auto is_blob_cacheable(const url&) noexcept -> bool final {
+        return true;
+    }
+
+    // bump the version when the sky shader or the parameters change
+    auto blob_cache_salt(const url& locator) noexcept -> std::string final {
+        return app::blob_cache_salt(
+          "sky1", get_blob_compression(*this, "cubemap_sky", locator));
+    }
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("cube_map_sky");
+    }
+
 private:
     const shared_provider_objects& _shared;
     application_config_value<int> _device_index{
@@ -550,6 +710,15 @@ private:
       main_context().config(),
       "application.resource_provider.cubemap_sky.blob_timeout",
       std::chrono::hours{12}};
+    application_config_value<int> _context_count{
+      main_context().config(),
+      "application.resource_provider.cubemap_sky.render_contexts",
+      1};
+    shared_holder<gl_rendered_blob_context_pool> _contexts{
+      default_selector,
+      as_parent()};
+    const std::shared_ptr<cubemap_sky_tiling_cache> _tilings{
+      std::make_shared<cubemap_sky_tiling_cache>()};
 };
 //------------------------------------------------------------------------------
 eagitexi_cubemap_sky_provider::eagitexi_cubemap_sky_provider(
@@ -576,16 +745,22 @@ auto eagitexi_cubemap_sky_provider::get_resource_io(const url& locator)
         gl_rendered_blob_params params{
           .device_index = _device_index.value(),
           .surface_width = size,
-          .surface_height = size};
+          .surface_height = size,
+          .compression = get_blob_compression(*this, "cubemap_sky", locator),
+          .contexts = _contexts,
+          .context_count = _context_count.value()};
 
         q.arg_value_as<int>("device_index")
           .and_then(_1.assign_to(params.device_index));
+        q.arg_value_as<int>("render_contexts")
+          .and_then(_1.assign_to(params.context_count));
 
         return {
           hold<eagitexi_cubemap_sky_io>,
           as_parent(),
           _shared,
           params,
+          _tilings,
           locator,
           size};
     }
@@ -623,8 +798,22 @@ eagitex_cubemap_sky_io::eagitex_cubemap_sky_io(
 auto eagitex_cubemap_sky_io::make_header(const url& locator, int size)
   -> std::string {
     const auto& q{locator.query()};
+    // In the progressive mode only a cheap, low-resolution mipmap level is
+    // rendered and used as the base level of the full-size texture.
+    // The full-resolution image is supposed to be loaded later by updating
+    // level zero of the texture and by resetting its base level.
+    int level{0};
+    if(q.arg_has_value("progressive", true)) {
+        level = std::max(q.arg_value_as<int>("preview_level").value_or(3), 0);
+        while((level > 0) and ((size >> level) < 1)) {
+            --level;
+        }
+    }
     std::stringstream hdr;
-    hdr << R"({"levels":1)";
+    hdr << R"({"levels":)" << (level + 1);
+    if(level > 0) {
+        hdr << R"(,"base_level":)" << level;
+    }
     hdr << R"(,"width":)" << size;
     hdr << R"(,"height":)" << size;
     hdr << R"(,"channels":4)";
@@ -636,19 +825,16 @@ auto eagitex_cubemap_sky_io::make_header(const url& locator, int size)
     hdr << R"(,"tag":["sky","cubemap","generated"])";
     hdr << R"(,"images":[)";
     hdr << R"({"url":"eagitexi:///cube_map_sky)";
+    hdr << "?size=" << (size >> level);
+    if(level > 0) {
+        hdr << "&level=" << level;
+    }
 
-    auto add{[&, first{true}]<typename T>(std::string_view name) mutable {
+    auto add{[&]<typename T>(std::string_view name) {
         if(const auto opt{q.arg_value_as<T>(name)}) {
-            if(first) {
-                hdr << '?';
-                first = false;
-            } else {
-                hdr << '&';
-            }
-            hdr << name << '=' << *opt;
+            hdr << '&' << name << '=' << *opt;
         }
     }};
-    add.operator()<int>("size");
     add.operator()<float>("planet_radius_m");
     add.operator()<float>("atm_thickness_m");
     add.operator()<float>("vapor_thickness_ratio");
@@ -684,6 +870,11 @@ public:
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
 
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("cube_map_sky");
+    }
+
 private:
 };
 //------------------------------------------------------------------------------
@@ -31,6 +31,17 @@ struct pixel_provider_interface : interface<pixel_provider_interface> {
       -> span_size_t = 0;
 
     virtual auto pixel_byte(pixel_provider_coordinate) noexcept -> byte = 0;
+
+    /// @brief Fills a row of width pixels at the y and z of the coordinate.
+    /// @details The bytes of the specified number of channels of each pixel
+    /// are stored interleaved. The default implementation calls pixel_byte
+    /// for each of the bytes, providers should override it to fill whole
+    /// runs of identical bytes at once. Rows of large images are filled
+    /// concurrently from several threads.
+    virtual void fill_row(
+      pixel_provider_coordinate,
+      int channels,
+      memory::block row) noexcept;
 };
 //------------------------------------------------------------------------------
 struct pixel_provider_factory_interface
@@ -42,19 +53,19 @@ struct pixel_provider_factory_interface
 };
 //------------------------------------------------------------------------------
 auto provider_eagitexi_2d_r8(
-  main_ctx_parent,
+  const provider_parameters&,
   std::string path,
   shared_holder<pixel_provider_factory_interface>)
   -> unique_holder<resource_provider_interface>;
 //------------------------------------------------------------------------------
 auto provider_eagitexi_3d_r8(
-  main_ctx_parent,
+  const provider_parameters&,
   std::string path,
   shared_holder<pixel_provider_factory_interface>)
   -> unique_holder<resource_provider_interface>;
 //------------------------------------------------------------------------------
 auto provider_eagitexi_2d_rgb8(
-  main_ctx_parent,
+  const provider_parameters&,
   std::string path,
   shared_holder<pixel_provider_factory_interface>)
   -> unique_holder<resource_provider_interface>;
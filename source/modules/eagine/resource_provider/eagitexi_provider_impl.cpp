@@ -9,6 +9,13 @@ module;
 
 #include <cassert>
 
+#if __has_include(<zlib.h>)
+#include <zlib.h>
+#define EAGINE_APP_HAS_ZLIB 1
+#else
+#define EAGINE_APP_HAS_ZLIB 0
+#endif
+
 module eagine.app.resource_provider;
 
 import eagine.core;
@@ -17,6 +24,252 @@ import std;
 
 namespace eagine::app {
 //------------------------------------------------------------------------------
+// pixel_provider_interface
+//------------------------------------------------------------------------------
+void pixel_provider_interface::fill_row(
+  pixel_provider_coordinate c,
+  int channels,
+  memory::block row) noexcept {
+    assert(row.size() >= span_size(c.width) * channels);
+    auto pos{row.begin()};
+    for(c.x = 0; c.x < c.width; ++c.x) {
+        for(c.component = 0; c.component < channels; ++c.component) {
+            *pos++ = pixel_byte(c);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// Fills the pixel rows and compresses them in chunks of several rows,
+// if the rows are short.
+static void compress_pixel_rows(
+  stream_compression& compress,
+  pixel_provider_interface& pixel_provider,
+  int w,
+  int h,
+  int d,
+  int channels,
+  data_compression_level level) {
+    const auto row_size{span_size(w) * channels};
+    const auto rows_per_chunk{
+      std::max(span_size(16 * 1024) / row_size, span_size(1))};
+    std::vector<byte> chunk(std_size(row_size * rows_per_chunk));
+    span_size_t filled{0};
+
+    for(int z = 0; z < d; ++z) {
+        for(int y = 0; y < h; ++y) {
+            pixel_provider.fill_row(
+              {.width = w, .height = h, .depth = d, .y = y, .z = z},
+              channels,
+              head(skip(cover(chunk), filled), row_size));
+            filled += row_size;
+            if(filled == span_size(chunk.size())) {
+                compress.next(view(chunk), level);
+                filled = 0;
+            }
+        }
+    }
+    if(filled > 0) {
+        compress.next(head(view(chunk), filled), level);
+    }
+}
+//------------------------------------------------------------------------------
+// Fills the pixel rows directly into the data buffer, without compression.
+static void append_pixel_rows(
+  memory::buffer& data,
+  pixel_provider_interface& pixel_provider,
+  int w,
+  int h,
+  int d,
+  int channels) {
+    const auto row_size{span_size(w) * channels};
+    auto offset{data.size()};
+    data.resize(offset + row_size * h * d);
+
+    for(int z = 0; z < d; ++z) {
+        for(int y = 0; y < h; ++y) {
+            pixel_provider.fill_row(
+              {.width = w, .height = h, .depth = d, .y = y, .z = z},
+              channels,
+              head(skip(cover(data), offset), row_size));
+            offset += row_size;
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// Large images are split into bands of rows, which are generated and
+// compressed by several threads into raw deflate blocks, terminated by
+// a sync flush. The blocks are then concatenated in order and wrapped into
+// a zlib header and the combined checksum, which results in a valid zlib
+// stream, like the one produced by the stream compression.
+#if EAGINE_APP_HAS_ZLIB
+struct compressed_pixel_band {
+    std::vector<byte> data;
+    ::uLong checksum{::adler32(0L, nullptr, 0U)};
+    ::uLong size{0U};
+    bool failed{false};
+};
+//------------------------------------------------------------------------------
+static void compress_pixel_band(
+  compressed_pixel_band& band,
+  pixel_provider_interface& pixel_provider,
+  int w,
+  int h,
+  int d,
+  int channels,
+  int first_row,
+  int end_row,
+  int zlib_level,
+  bool is_last) noexcept {
+    ::z_stream zs{};
+    const auto init_result{::deflateInit2(
+      &zs, zlib_level, Z_DEFLATED, -MAX_WBITS, 9, Z_DEFAULT_STRATEGY)};
+    if(init_result != Z_OK) {
+        band.failed = true;
+        return;
+    }
+    const auto row_size{span_size(w) * channels};
+    std::vector<byte> rows(std_size(row_size));
+    std::array<byte, 16 * 1024> out{};
+
+    const auto deflate_rows{[&](memory::const_block input, int flush) {
+        zs.next_in = const_cast<::Bytef*>(input.data());
+        zs.avail_in = static_cast<::uInt>(input.size());
+        do {
+            zs.next_out = out.data();
+            zs.avail_out = static_cast<::uInt>(out.size());
+            if(::deflate(&zs, flush) == Z_STREAM_ERROR) {
+                band.failed = true;
+                return;
+            }
+            band.data.insert(band.data.end(), out.data(), zs.next_out);
+        } while(zs.avail_out == 0U);
+    }};
+
+    try {
+        for(int r = first_row; r < end_row and not band.failed; ++r) {
+            pixel_provider.fill_row(
+              {.width = w, .height = h, .depth = d, .y = r % h, .z = r / h},
+              channels,
+              cover(rows));
+            band.checksum = ::adler32(
+              band.checksum, rows.data(), static_cast<::uInt>(rows.size()));
+            band.size += rows.size();
+            deflate_rows(view(rows), Z_NO_FLUSH);
+        }
+        deflate_rows({}, is_last ? Z_FINISH : Z_SYNC_FLUSH);
+    } catch(...) {
+        band.failed = true;
+    }
+    ::deflateEnd(&zs);
+}
+#endif
+//------------------------------------------------------------------------------
+static auto compress_pixel_bands(
+  memory::buffer& data,
+  blob_prepare_pool& workers,
+  pixel_provider_interface& pixel_provider,
+  int w,
+  int h,
+  int d,
+  int channels,
+  data_compression_level level) -> bool {
+#if EAGINE_APP_HAS_ZLIB
+    // the second byte of the zlib header must match the compression level
+    int zlib_level{Z_BEST_COMPRESSION};
+    byte header_flags{0xDAU};
+    if(level == data_compression_level::lowest) {
+        zlib_level = Z_BEST_SPEED;
+        header_flags = 0x01U;
+    } else if(level == data_compression_level::normal) {
+        zlib_level = Z_DEFAULT_COMPRESSION;
+        header_flags = 0x9CU;
+    }
+
+    const auto row_size{span_size(w) * channels};
+    const auto rows_per_band{
+      int(std::max(span_size(1024 * 1024) / row_size, span_size(1)))};
+    const auto row_count{h * d};
+    const auto band_count{(row_count + rows_per_band - 1) / rows_per_band};
+    const auto helper_count{
+      std::min(band_count - 1, int(workers.worker_count()))};
+    if((band_count < 2) or (helper_count < 1)) {
+        return false;
+    }
+
+    // The bands are claimed by this thread and by helpers queued in the
+    // prepare pool. This thread works on the unclaimed bands itself and
+    // waits only for the bands already being compressed by the helpers,
+    // so it cannot deadlock even when called from a pool worker.
+    // Helpers started after everything is claimed just return.
+    struct band_state {
+        std::vector<compressed_pixel_band> bands;
+        std::atomic<int> next_band{0};
+        int done_count{0};
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state{std::make_shared<band_state>()};
+    state->bands.resize(std_size(band_count));
+    const auto compress_bands{[=, &pixel_provider](band_state& st) {
+        int done_count{0};
+        for(int b = st.next_band++; b < band_count; b = st.next_band++) {
+            compress_pixel_band(
+              st.bands[std_size(b)],
+              pixel_provider,
+              w,
+              h,
+              d,
+              channels,
+              b * rows_per_band,
+              std::min((b + 1) * rows_per_band, row_count),
+              zlib_level,
+              b + 1 == band_count);
+            ++done_count;
+        }
+        if(done_count > 0) {
+            const std::unique_lock lock{st.mutex};
+            st.done_count += done_count;
+        }
+        st.done.notify_all();
+    }};
+    for(int t = 0; t < helper_count; ++t) {
+        workers.enqueue([state, compress_bands](const std::stop_token&) {
+            compress_bands(*state);
+        });
+    }
+    compress_bands(*state);
+    {
+        std::unique_lock lock{state->mutex};
+        state->done.wait(
+          lock, [&] { return state->done_count == band_count; });
+    }
+    const auto& bands{state->bands};
+
+    ::uLong checksum{::adler32(0L, nullptr, 0U)};
+    for(const auto& band : bands) {
+        if(band.failed) {
+            return false;
+        }
+        checksum = ::adler32_combine(
+          checksum, band.checksum, static_cast<::z_off_t>(band.size));
+    }
+    const std::array<byte, 2> header{{0x78U, header_flags}};
+    memory::append_to(view(header), data);
+    for(const auto& band : bands) {
+        memory::append_to(view(band.data), data);
+    }
+    const std::array<byte, 4> trailer{
+      {byte((checksum >> 24U) & 0xFFU),
+       byte((checksum >> 16U) & 0xFFU),
+       byte((checksum >> 8U) & 0xFFU),
+       byte(checksum & 0xFFU)}};
+    memory::append_to(view(trailer), data);
+    return true;
+#else
+    return false;
+#endif
+}
+//------------------------------------------------------------------------------
 // 2d_r8
 //------------------------------------------------------------------------------
 struct eagitexi_2d_r8_io final : simple_buffer_source_blob_io {
@@ -36,10 +289,16 @@ struct eagitexi_2d_r8_io final : simple_buffer_source_blob_io {
 
     eagitexi_2d_r8_io(
       main_ctx_parent parent,
+      blob_prepare_pool& pool,
       unique_holder<pixel_provider_interface> provider,
       int w,
       int h,
-      int l);
+      int l,
+      const blob_compression&);
+
+    blob_prepare_pool& workers;
+    unique_holder<pixel_provider_interface> pixels;
+    const blob_compression compression;
 };
 //------------------------------------------------------------------------------
 auto eagitexi_2d_r8_io::make_header(
@@ -57,7 +316,7 @@ auto eagitexi_2d_r8_io::make_header(
     hdr << R"(,"format":"red")";
     hdr << R"(,"iformat":"r8")";
     hdr << R"(,"tag":["generated"])";
-    hdr << R"(,"data_filter":"zlib")";
+    hdr << R"(,"data_filter":")" << compression.data_filter() << '"';
     hdr << '}';
     memory::copy_into(as_bytes(string_view{hdr.str()}), header);
     return header;
@@ -68,6 +327,15 @@ auto eagitexi_2d_r8_io::make_data(
   pixel_provider_interface& pixel_provider,
   int w,
   int h) -> memory::buffer {
+    assert(pixel_provider.pixel_byte_count() == 1);
+    if(compression.is_none()) {
+        append_pixel_rows(data, pixel_provider, w, h, 1, 1);
+        return data;
+    }
+    if(compress_pixel_bands(
+         data, workers, pixel_provider, w, h, 1, 1, compression.level)) {
+        return data;
+    }
     const auto append{[&](memory::const_block packed) {
         memory::append_to(packed, data);
         return true;
@@ -77,45 +345,34 @@ auto eagitexi_2d_r8_io::make_data(
       {construct_from, append},
       default_data_compression_method()};
 
-    std::array<byte, 4 * 1024> buf;
-    std::size_t i{0U};
-
-    assert(pixel_provider.pixel_byte_count() == 1);
-    for(int y = 0; y < h; ++y) {
-        for(int x = 0; x < w; ++x) {
-            buf[i++] = pixel_provider.pixel_byte(
-              {.width = w, .height = h, .x = x, .y = y});
-            if(i == buf.size()) {
-                compress.next(view(buf), data_compression_level::highest);
-                i = 0U;
-            }
-        }
-    }
-    if(i > 0) {
-        compress.next(
-          head(view(buf), span_size(i)), data_compression_level::highest);
-    }
+    compress_pixel_rows(
+      compress, pixel_provider, w, h, 1, 1, compression.level);
     compress.finish();
     return data;
 }
 //------------------------------------------------------------------------------
 eagitexi_2d_r8_io::eagitexi_2d_r8_io(
   main_ctx_parent parent,
+  blob_prepare_pool& pool,
   unique_holder<pixel_provider_interface> provider,
   int w,
   int h,
-  int l)
+  int l,
+  const blob_compression& c)
   : simple_buffer_source_blob_io{
       "ITx2R8",
       parent,
       provider->estimated_data_size(w, h, 1),
-      [&](memory::buffer content) {
+      [this, w, h, l](memory::buffer content) {
           return make_data(
-            make_header(std::move(content), *provider, w, h, l),
-            *provider,
+            make_header(std::move(content), *pixels, w, h, l),
+            *pixels,
             w,
             h);
-      }} {}
+      }}
+  , workers{pool}
+  , pixels{std::move(provider)}
+  , compression{c} {}
 //------------------------------------------------------------------------------
 // provider
 //------------------------------------------------------------------------------
@@ -124,9 +381,10 @@ struct eagitexi_2d_r8_provider final
   , resource_provider_interface {
     std::string url_path;
     shared_holder<pixel_provider_factory_interface> factory;
+    blob_prepare_pool& workers;
 
     eagitexi_2d_r8_provider(
-      main_ctx_parent parent,
+      const provider_parameters& params,
       std::string path,
       shared_holder<pixel_provider_factory_interface> f) noexcept;
 
@@ -145,15 +403,21 @@ struct eagitexi_2d_r8_provider final
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback(url_path);
+    }
 };
 //------------------------------------------------------------------------------
 eagitexi_2d_r8_provider::eagitexi_2d_r8_provider(
-  main_ctx_parent parent,
+  const provider_parameters& params,
   std::string path,
   shared_holder<pixel_provider_factory_interface> f) noexcept
-  : main_ctx_object{"PTx2R8", parent}
+  : main_ctx_object{"PTx2R8", params.parent}
   , url_path{path}
-  , factory{std::move(f)} {}
+  , factory{std::move(f)}
+  , workers{params.shared.workers} {}
 //------------------------------------------------------------------------------
 auto eagitexi_2d_r8_provider::has_resource(const url& locator) noexcept
   -> bool {
@@ -171,13 +435,15 @@ auto eagitexi_2d_r8_provider::has_resource(const url& locator) noexcept
 auto eagitexi_2d_r8_provider::get_resource_io(const url& locator)
   -> shared_holder<msgbus::source_blob_io> {
     const auto& q{locator.query()};
-    return {
-      hold<eagitexi_2d_r8_io>,
-      as_parent(),
-      factory->make_provider(locator),
-      q.arg_value_as<int>("width").value_or(2),
-      q.arg_value_as<int>("height").value_or(2),
-      q.arg_value_as<int>("level").value_or(0)};
+    return workers.prepare_in_background(
+      {hold<eagitexi_2d_r8_io>,
+       as_parent(),
+       workers,
+       factory->make_provider(locator),
+       q.arg_value_as<int>("width").value_or(2),
+       q.arg_value_as<int>("height").value_or(2),
+       q.arg_value_as<int>("level").value_or(0),
+       get_blob_compression(*this, "eagitexi", locator)});
 }
 //------------------------------------------------------------------------------
 void eagitexi_2d_r8_provider::for_each_locator(
@@ -186,14 +452,14 @@ void eagitexi_2d_r8_provider::for_each_locator(
 }
 //------------------------------------------------------------------------------
 auto provider_eagitexi_2d_r8(
-  main_ctx_parent parent,
+  const provider_parameters& params,
   std::string path,
   shared_holder<pixel_provider_factory_interface> factory)
   -> unique_holder<resource_provider_interface> {
     assert(factory);
     return {
       hold<eagitexi_2d_r8_provider>,
-      parent,
+      params,
       std::move(path),
       std::move(factory)};
 }
@@ -219,11 +485,17 @@ struct eagitexi_3d_r8_io final : simple_buffer_source_blob_io {
 
     eagitexi_3d_r8_io(
       main_ctx_parent parent,
+      blob_prepare_pool& pool,
       unique_holder<pixel_provider_interface> provider,
       int w,
       int h,
       int d,
-      int l);
+      int l,
+      const blob_compression&);
+
+    blob_prepare_pool& workers;
+    unique_holder<pixel_provider_interface> pixels;
+    const blob_compression compression;
 };
 //------------------------------------------------------------------------------
 auto eagitexi_3d_r8_io::make_header(
@@ -243,7 +515,7 @@ auto eagitexi_3d_r8_io::make_header(
     hdr << R"(,"format":"red")";
     hdr << R"(,"iformat":"r8")";
     hdr << R"(,"tag":["generated"])";
-    hdr << R"(,"data_filter":"zlib")";
+    hdr << R"(,"data_filter":")" << compression.data_filter() << '"';
     hdr << '}';
     memory::copy_into(as_bytes(string_view{hdr.str()}), header);
     return header;
@@ -255,6 +527,15 @@ auto eagitexi_3d_r8_io::make_data(
   int w,
   int h,
   int d) -> memory::buffer {
+    assert(pixel_provider.pixel_byte_count() == 1);
+    if(compression.is_none()) {
+        append_pixel_rows(data, pixel_provider, w, h, d, 1);
+        return data;
+    }
+    if(compress_pixel_bands(
+         data, workers, pixel_provider, w, h, d, 1, compression.level)) {
+        return data;
+    }
     const auto append{[&](memory::const_block packed) {
         memory::append_to(packed, data);
         return true;
@@ -264,58 +545,46 @@ auto eagitexi_3d_r8_io::make_data(
       {construct_from, append},
       default_data_compression_method()};
 
-    std::array<byte, 16 * 1024> buf;
-    std::size_t i{0U};
-
-    assert(pixel_provider.pixel_byte_count() == 1);
-    for(int z = 0; z < d; ++z) {
-        for(int y = 0; y < h; ++y) {
-            for(int x = 0; x < w; ++x) {
-                buf[i++] = pixel_provider.pixel_byte(
-                  {.width = w, .height = h, .depth = d, .x = x, .y = y, .z = z});
-                if(i == buf.size()) {
-                    compress.next(view(buf), data_compression_level::highest);
-                    i = 0U;
-                }
-            }
-        }
-    }
-    if(i > 0) {
-        compress.next(
-          head(view(buf), span_size(i)), data_compression_level::highest);
-    }
+    compress_pixel_rows(
+      compress, pixel_provider, w, h, d, 1, compression.level);
     compress.finish();
     return data;
 }
 //------------------------------------------------------------------------------
 eagitexi_3d_r8_io::eagitexi_3d_r8_io(
   main_ctx_parent parent,
+  blob_prepare_pool& pool,
   unique_holder<pixel_provider_interface> provider,
   int w,
   int h,
   int d,
-  int l)
+  int l,
+  const blob_compression& c)
   : simple_buffer_source_blob_io{
       "ITx3R8",
       parent,
       provider->estimated_data_size(w, h, d),
-      [&](memory::buffer content) {
+      [this, w, h, d, l](memory::buffer content) {
           return make_data(
-            make_header(std::move(content), *provider, w, h, d, l),
-            *provider,
+            make_header(std::move(content), *pixels, w, h, d, l),
+            *pixels,
             w,
             h,
             d);
-      }} {}
+      }}
+  , workers{pool}
+  , pixels{std::move(provider)}
+  , compression{c} {}
 //------------------------------------------------------------------------------
 struct eagitexi_3d_r8_provider final
   : main_ctx_object
   , resource_provider_interface {
     std::string url_path;
     shared_holder<pixel_provider_factory_interface> factory;
+    blob_prepare_pool& workers;
 
     eagitexi_3d_r8_provider(
-      main_ctx_parent parent,
+      const provider_parameters& params,
       std::string path,
       shared_holder<pixel_provider_factory_interface> f) noexcept;
 
@@ -334,15 +603,21 @@ struct eagitexi_3d_r8_provider final
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback(url_path);
+    }
 };
 //------------------------------------------------------------------------------
 eagitexi_3d_r8_provider::eagitexi_3d_r8_provider(
-  main_ctx_parent parent,
+  const provider_parameters& params,
   std::string path,
   shared_holder<pixel_provider_factory_interface> f) noexcept
-  : main_ctx_object{"PTx3R8", parent}
+  : main_ctx_object{"PTx3R8", params.parent}
   , url_path{path}
-  , factory{std::move(f)} {}
+  , factory{std::move(f)}
+  , workers{params.shared.workers} {}
 //------------------------------------------------------------------------------
 auto eagitexi_3d_r8_provider::has_resource(const url& locator) noexcept
   -> bool {
@@ -361,14 +636,16 @@ auto eagitexi_3d_r8_provider::has_resource(const url& locator) noexcept
 auto eagitexi_3d_r8_provider::get_resource_io(const url& locator)
   -> shared_holder<msgbus::source_blob_io> {
     const auto& q{locator.query()};
-    return {
-      hold<eagitexi_3d_r8_io>,
-      as_parent(),
-      factory->make_provider(locator),
-      q.arg_value_as<int>("width").value_or(2),
-      q.arg_value_as<int>("height").value_or(2),
-      q.arg_value_as<int>("depth").value_or(2),
-      q.arg_value_as<int>("level").value_or(0)};
+    return workers.prepare_in_background(
+      {hold<eagitexi_3d_r8_io>,
+       as_parent(),
+       workers,
+       factory->make_provider(locator),
+       q.arg_value_as<int>("width").value_or(2),
+       q.arg_value_as<int>("height").value_or(2),
+       q.arg_value_as<int>("depth").value_or(2),
+       q.arg_value_as<int>("level").value_or(0),
+       get_blob_compression(*this, "eagitexi", locator)});
 }
 //------------------------------------------------------------------------------
 void eagitexi_3d_r8_provider::for_each_locator(
@@ -377,14 +654,14 @@ void eagitexi_3d_r8_provider::for_each_locator(
 }
 //------------------------------------------------------------------------------
 auto provider_eagitexi_3d_r8(
-  main_ctx_parent parent,
+  const provider_parameters& params,
   std::string path,
   shared_holder<pixel_provider_factory_interface> factory)
   -> unique_holder<resource_provider_interface> {
     assert(factory);
     return {
       hold<eagitexi_3d_r8_provider>,
-      parent,
+      params,
       std::move(path),
       std::move(factory)};
 }
@@ -408,10 +685,16 @@ struct eagitexi_2d_rgb8_io final : simple_buffer_source_blob_io {
 
     eagitexi_2d_rgb8_io(
       main_ctx_parent parent,
+      blob_prepare_pool& pool,
       unique_holder<pixel_provider_interface> provider,
       int w,
       int h,
-      int l);
+      int l,
+      const blob_compression&);
+
+    blob_prepare_pool& workers;
+    unique_holder<pixel_provider_interface> pixels;
+    const blob_compression compression;
 };
 //------------------------------------------------------------------------------
 auto eagitexi_2d_rgb8_io::make_header(
@@ -429,7 +712,7 @@ auto eagitexi_2d_rgb8_io::make_header(
     hdr << R"(,"format":"rgb")";
     hdr << R"(,"iformat":"rgb8")";
     hdr << R"(,"tag":["generated"])";
-    hdr << R"(,"data_filter":"zlib")";
+    hdr << R"(,"data_filter":")" << compression.data_filter() << '"';
     hdr << '}';
     memory::copy_into(as_bytes(string_view{hdr.str()}), header);
     return header;
@@ -440,6 +723,15 @@ auto eagitexi_2d_rgb8_io::make_data(
   pixel_provider_interface& pixel_provider,
   int w,
   int h) -> memory::buffer {
+    assert(pixel_provider.pixel_byte_count() >= 3);
+    if(compression.is_none()) {
+        append_pixel_rows(data, pixel_provider, w, h, 1, 3);
+        return data;
+    }
+    if(compress_pixel_bands(
+         data, workers, pixel_provider, w, h, 1, 3, compression.level)) {
+        return data;
+    }
     const auto append{[&](memory::const_block packed) {
         memory::append_to(packed, data);
         return true;
@@ -449,56 +741,44 @@ auto eagitexi_2d_rgb8_io::make_data(
       {construct_from, append},
       default_data_compression_method()};
 
-    std::array<byte, 4 * 1024> buf;
-    std::size_t i{0U};
-
-    assert(pixel_provider.pixel_byte_count() >= 3);
-    for(int y = 0; y < h; ++y) {
-        for(int x = 0; x < w; ++x) {
-            for(int c = 0; c < 3; ++c) {
-                buf[i++] = pixel_provider.pixel_byte(
-                  {.width = w, .height = h, .x = x, .y = y, .component = c});
-                if(i == buf.size()) {
-                    compress.next(view(buf), data_compression_level::highest);
-                    i = 0U;
-                }
-            }
-        }
-    }
-    if(i > 0) {
-        compress.next(
-          head(view(buf), span_size(i)), data_compression_level::highest);
-    }
+    compress_pixel_rows(
+      compress, pixel_provider, w, h, 1, 3, compression.level);
     compress.finish();
     return data;
 }
 //------------------------------------------------------------------------------
 eagitexi_2d_rgb8_io::eagitexi_2d_rgb8_io(
   main_ctx_parent parent,
+  blob_prepare_pool& pool,
   unique_holder<pixel_provider_interface> provider,
   int w,
   int h,
-  int l)
+  int l,
+  const blob_compression& c)
   : simple_buffer_source_blob_io{
       "ITx2RGB8",
       parent,
       provider->estimated_data_size(w, h, 1),
-      [&](memory::buffer content) {
+      [this, w, h, l](memory::buffer content) {
           return make_data(
-            make_header(std::move(content), *provider, w, h, l),
-            *provider,
+            make_header(std::move(content), *pixels, w, h, l),
+            *pixels,
             w,
             h);
-      }} {}
+      }}
+  , workers{pool}
+  , pixels{std::move(provider)}
+  , compression{c} {}
 //------------------------------------------------------------------------------
 struct eagitexi_2d_rgb8_provider final
   : main_ctx_object
   , resource_provider_interface {
     std::string url_path;
     shared_holder<pixel_provider_factory_interface> factory;
+    blob_prepare_pool& workers;
 
     eagitexi_2d_rgb8_provider(
-      main_ctx_parent parent,
+      const provider_parameters& params,
       std::string path,
       shared_holder<pixel_provider_factory_interface> f) noexcept;
 
@@ -517,15 +797,21 @@ struct eagitexi_2d_rgb8_provider final
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback(url_path);
+    }
 };
 //------------------------------------------------------------------------------
 eagitexi_2d_rgb8_provider::eagitexi_2d_rgb8_provider(
-  main_ctx_parent parent,
+  const provider_parameters& params,
   std::string path,
   shared_holder<pixel_provider_factory_interface> f) noexcept
-  : main_ctx_object{"PTx2RGB8", parent}
+  : main_ctx_object{"PTx2RGB8", params.parent}
   , url_path{path}
-  , factory{std::move(f)} {}
+  , factory{std::move(f)}
+  , workers{params.shared.workers} {}
 //------------------------------------------------------------------------------
 auto eagitexi_2d_rgb8_provider::has_resource(const url& locator) noexcept
   -> bool {
@@ -543,13 +829,15 @@ auto eagitexi_2d_rgb8_provider::has_resource(const url& locator) noexcept
 auto eagitexi_2d_rgb8_provider::get_resource_io(const url& locator)
   -> shared_holder<msgbus::source_blob_io> {
     const auto& q{locator.query()};
-    return {
-      hold<eagitexi_2d_rgb8_io>,
-      as_parent(),
-      factory->make_provider(locator),
-      q.arg_value_as<int>("width").value_or(2),
-      q.arg_value_as<int>("height").value_or(2),
-      q.arg_value_as<int>("level").value_or(0)};
+    return workers.prepare_in_background(
+      {hold<eagitexi_2d_rgb8_io>,
+       as_parent(),
+       workers,
+       factory->make_provider(locator),
+       q.arg_value_as<int>("width").value_or(2),
+       q.arg_value_as<int>("height").value_or(2),
+       q.arg_value_as<int>("level").value_or(0),
+       get_blob_compression(*this, "eagitexi", locator)});
 }
 //------------------------------------------------------------------------------
 void eagitexi_2d_rgb8_provider::for_each_locator(
@@ -558,14 +846,14 @@ void eagitexi_2d_rgb8_provider::for_each_locator(
 }
 //------------------------------------------------------------------------------
 auto provider_eagitexi_2d_rgb8(
-  main_ctx_parent parent,
+  const provider_parameters& params,
   std::string path,
   shared_holder<pixel_provider_factory_interface> factory)
   -> unique_holder<resource_provider_interface> {
     assert(factory);
     return {
       hold<eagitexi_2d_rgb8_provider>,
-      parent,
+      params,
       std::move(path),
       std::move(factory)};
 }
@@ -116,6 +116,11 @@ struct eagitexi_random_provider final
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/random");
+    }
 };
 //------------------------------------------------------------------------------
 auto eagitexi_random_provider::has_resource(const url& locator) noexcept
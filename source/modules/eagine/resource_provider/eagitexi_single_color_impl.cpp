@@ -37,6 +37,22 @@ struct single_rgb8_pixel_provider : pixel_provider_interface {
         assert(c.component >= 0 and c.component <= 3);
         return rgb[std_size(c.component)];
     }
+
+    void fill_row(
+      pixel_provider_coordinate c,
+      int channels,
+      memory::block row) noexcept final {
+        assert(channels >= 1 and channels <= 3);
+        const auto pixel{head(view(rgb), channels)};
+        const auto done{copy(pixel, row).size()};
+        // double the already filled part of the row until it is complete
+        const auto total{span_size(c.width) * channels};
+        for(auto filled{done}; filled < total;) {
+            const auto len{std::min(filled, total - filled)};
+            copy(head(view(row), len), skip(row, filled));
+            filled += len;
+        }
+    }
 };
 //------------------------------------------------------------------------------
 struct single_rgb8_pixel_provider_factory : pixel_provider_factory_interface {
@@ -74,7 +90,7 @@ struct single_rgb8_pixel_provider_factory : pixel_provider_factory_interface {
 auto provider_eagitexi_2d_single_rgb8(const provider_parameters& p)
   -> unique_holder<resource_provider_interface> {
     return provider_eagitexi_2d_rgb8(
-      p.parent, "/2d_single_rgb8", {hold<single_rgb8_pixel_provider_factory>});
+      p, "/2d_single_rgb8", {hold<single_rgb8_pixel_provider_factory>});
 }
 //------------------------------------------------------------------------------
 // eagitex
@@ -142,6 +158,11 @@ struct single_rgb8_eagitex_provider final : eagitex_provider_base {
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/2d_single_rgb8");
+    }
 };
 //------------------------------------------------------------------------------
 auto single_rgb8_eagitex_provider::has_resource(const url& locator) noexcept
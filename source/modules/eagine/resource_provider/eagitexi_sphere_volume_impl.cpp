@@ -51,7 +51,7 @@ struct sphere_volume_pixel_provider_factory : pixel_provider_factory_interface {
 auto provider_eagitexi_sphere_volume(const provider_parameters& p)
   -> unique_holder<resource_provider_interface> {
     return provider_eagitexi_3d_r8(
-      p.parent, "/sphere_volume", {hold<sphere_volume_pixel_provider_factory>});
+      p, "/sphere_volume", {hold<sphere_volume_pixel_provider_factory>});
 }
 //------------------------------------------------------------------------------
 // eagitex
@@ -100,6 +100,11 @@ struct sphere_volume_eagitex_provider final : eagitex_provider_base {
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/sphere_volume");
+    }
 };
 //------------------------------------------------------------------------------
 auto sphere_volume_eagitex_provider::has_resource(const url& locator) noexcept
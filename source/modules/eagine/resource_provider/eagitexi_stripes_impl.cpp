@@ -39,6 +39,20 @@ struct stripes_r8_pixel_provider : pixel_provider_interface {
         return ((c.x + c.y + c.z) % 2 == 0) ? 0x00U : 0xFFU;
     }
 
+    void fill_row(
+      pixel_provider_coordinate c,
+      int channels,
+      memory::block row) noexcept final {
+        assert(channels == 1);
+        const auto offs{c.y / size + c.z / size};
+        auto pos{row.begin()};
+        for(int x = 0; x < c.width; x += size) {
+            const auto len{std::min(size, c.width - x)};
+            const bool black{(x / size + offs) % 2 == 0};
+            pos = std::fill_n(pos, len, black ? byte(0x00U) : byte(0xFFU));
+        }
+    }
+
     int size;
 };
 //------------------------------------------------------------------------------
@@ -64,7 +78,7 @@ struct stripes_r8_pixel_provider_factory : pixel_provider_factory_interface {
 auto provider_eagitexi_2d_stripes_r8(const provider_parameters& p)
   -> unique_holder<resource_provider_interface> {
     return provider_eagitexi_2d_r8(
-      p.parent, "/2d_stripes_r8", {hold<stripes_r8_pixel_provider_factory>});
+      p, "/2d_stripes_r8", {hold<stripes_r8_pixel_provider_factory>});
 }
 //------------------------------------------------------------------------------
 } // namespace eagine::app
@@ -22,7 +22,11 @@ namespace eagine::app {
 //------------------------------------------------------------------------------
 class eagitexi_tiling_io final : public compressed_buffer_source_blob_io {
 public:
-    eagitexi_tiling_io(main_ctx_parent, shared_provider_objects&, const url&);
+    eagitexi_tiling_io(
+      main_ctx_parent,
+      shared_provider_objects&,
+      const url&,
+      const blob_compression&);
     eagitexi_tiling_io(eagitexi_tiling_io&&) = delete;
     eagitexi_tiling_io(const eagitexi_tiling_io&) = delete;
     auto operator=(eagitexi_tiling_io&&) = delete;
@@ -51,8 +55,13 @@ private:
 eagitexi_tiling_io::eagitexi_tiling_io(
   main_ctx_parent parent,
   shared_provider_objects& shared,
-  const url& locator)
-  : compressed_buffer_source_blob_io{"ITxTlng", parent, 1024 * 1024}
+  const url& locator,
+  const blob_compression& compression)
+  : compressed_buffer_source_blob_io{
+      "ITxTlng",
+      parent,
+      1024 * 1024,
+      compression}
   , _shared{shared}
   , _tiling{locator, shared.old_loader} {
     append(R"({"level":0,"channels":1,"data_type":"unsigned_byte")");
@@ -79,7 +88,7 @@ void eagitexi_tiling_io::_process_line(const string_view line) {
             std::stringstream hdr;
             hdr << R"(,"width":)" << line.size();
             hdr << R"(,"height":)" << line.size();
-            hdr << R"(,"data_filter":"zlib")";
+            hdr << R"(,"data_filter":")" << data_filter() << '"';
             hdr << '}';
             append(hdr.str());
         }
@@ -129,6 +138,20 @@ struct eagitexi_tiling_provider final
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    auto is_blob_cacheable(const url&) noexcept -> bool final {
+        return true;
+    }
+
+    auto blob_cache_salt(const url& locator) noexcept -> std::string final {
+        return app::blob_cache_salt(
+          "tiling1", get_blob_compression(*this, "tiling", locator));
+    }
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/tiling");
+    }
 };
 //------------------------------------------------------------------------------
 auto eagitexi_tiling_provider::valid_source(const url& locator) noexcept
@@ -153,7 +176,12 @@ auto eagitexi_tiling_provider::has_resource(const url& locator) noexcept
 auto eagitexi_tiling_provider::get_resource_io(const url& locator)
   -> shared_holder<msgbus::source_blob_io> {
     const auto& q{locator.query()};
-    return {hold<eagitexi_tiling_io>, as_parent(), shared, q.arg_url("source")};
+    return {
+      hold<eagitexi_tiling_io>,
+      as_parent(),
+      shared,
+      q.arg_url("source"),
+      get_blob_compression(*this, "tiling", locator)};
 }
 //------------------------------------------------------------------------------
 void eagitexi_tiling_provider::for_each_locator(
@@ -403,6 +431,12 @@ public:
       span_size_t seed,
       url);
 
+    // loading of the source tiling has to be done on the main thread
+    auto is_ready_for_background() noexcept -> bool {
+        _tiling_loaded = _tiling_loaded or _tiling.is_loaded();
+        return _tiling_loaded;
+    }
+
     auto prepare() noexcept -> msgbus::blob_preparation_result final;
 
 private:
@@ -418,6 +452,7 @@ private:
     std::vector<float> _noise;
     std::size_t _pixel_index{0};
     std::size_t _value_index{0};
+    bool _tiling_loaded{false};
     bool _header_done{false};
     bool _values_done{false};
 };
@@ -452,7 +487,7 @@ auto eagitexi_tiling_noise_io::_get_weight(std::size_t i) const noexcept
 //------------------------------------------------------------------------------
 auto eagitexi_tiling_noise_io::prepare() noexcept
   -> msgbus::blob_preparation_result {
-    if(not _tiling.is_loaded()) {
+    if(not is_ready_for_background()) {
         return {msgbus::blob_preparation_status::working};
     }
     if(_width == 0) {
@@ -549,6 +584,19 @@ struct eagitexi_tiling_noise_provider final
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    auto is_blob_cacheable(const url&) noexcept -> bool final {
+        return true;
+    }
+
+    auto blob_cache_salt(const url&) noexcept -> std::string final {
+        return "noise1";
+    }
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/tiling_noise");
+    }
 };
 //------------------------------------------------------------------------------
 auto eagitexi_tiling_noise_provider::valid_source(const url& locator) noexcept
@@ -576,7 +624,7 @@ auto eagitexi_tiling_noise_provider::has_resource(const url& locator) noexcept
 auto eagitexi_tiling_noise_provider::get_resource_io(const url& locator)
   -> shared_holder<msgbus::source_blob_io> {
     const auto& q{locator.query()};
-    return {
+    shared_holder<msgbus::source_blob_io> io{
       hold<eagitexi_tiling_noise_io>,
       as_parent(),
       shared,
@@ -584,6 +632,10 @@ auto eagitexi_tiling_noise_provider::get_resource_io(const url& locator)
       q.arg_value_as<span_size_t>("height").value_or(0),
       q.arg_value_as<span_size_t>("seed").value_or(0),
       q.decoded_arg_value("source").or_default()};
+    auto& noise{static_cast<eagitexi_tiling_noise_io&>(*io)};
+    return shared.workers.prepare_in_background(std::move(io), [&noise] {
+        return noise.is_ready_for_background();
+    });
 }
 //------------------------------------------------------------------------------
 void eagitexi_tiling_noise_provider::for_each_locator(
@@ -231,7 +231,8 @@ class eagitexi_tiling_transition_io final
 public:
     eagitexi_tiling_transition_io(
       main_ctx_parent,
-      shared_holder<tiling_transition_mask>) noexcept;
+      shared_holder<tiling_transition_mask>,
+      const blob_compression&) noexcept;
 
     auto prepare() noexcept -> msgbus::blob_preparation_result final;
 
@@ -272,8 +273,13 @@ private:
 //------------------------------------------------------------------------------
 eagitexi_tiling_transition_io::eagitexi_tiling_transition_io(
   main_ctx_parent parent,
-  shared_holder<tiling_transition_mask> mask) noexcept
-  : compressed_buffer_source_blob_io{"TiTrTexIO", parent, _buf_size(mask)}
+  shared_holder<tiling_transition_mask> mask,
+  const blob_compression& compression) noexcept
+  : compressed_buffer_source_blob_io{
+      "TiTrTexIO",
+      parent,
+      _buf_size(mask),
+      compression}
   , _mask{std::move(mask)} {
     append(R"({"level":0,"channels":1,"data_type":"unsigned_byte")");
     append(R"(,"tag":["generator","transition"])");
@@ -362,7 +368,9 @@ auto eagitexi_tiling_transition_io::prepare() noexcept
             hdr << R"(,"width":)" << _width;
             hdr << R"(,"height":)" << _height;
             append(hdr.str());
-            append(R"(,"data_filter":"zlib"})");
+            append(R"(,"data_filter":")");
+            append(data_filter());
+            append(R"("})");
             _header_done = true;
         }
         for(int i = 0, n = _mask->batch_size(); i < n; ++i) {
@@ -409,6 +417,11 @@ public:
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
 
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/tiling_transition");
+    }
+
 private:
     tiling_transition_mask_factory _mask_factory;
 };
@@ -427,7 +440,8 @@ auto eagitexi_tiling_transition_provider::get_resource_io(const url& locator)
     return {
       hold<eagitexi_tiling_transition_io>,
       as_parent(),
-      _mask_factory.make_mask(locator)};
+      _mask_factory.make_mask(locator),
+      get_blob_compression(*this, "tiling_transition", locator)};
 }
 //------------------------------------------------------------------------------
 void eagitexi_tiling_transition_provider::for_each_locator(
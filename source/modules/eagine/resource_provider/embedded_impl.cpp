@@ -30,7 +30,9 @@ embedded_resource_io::embedded_resource_io(
       "EmbdRsrcIO",
       parent,
       16 * 1024,
-      [&](memory::buffer content) {
+      // the content is unpacked later in prepare, so the resource (just
+      // a view of the embedded data) must be captured by value
+      [this, res](memory::buffer content) {
           content.clear();
           res.unpack(main_context().compressor(), content);
           return content;
@@ -5,6 +5,16 @@
 /// See accompanying file LICENSE_1_0.txt or copy at
 /// https://www.boost.org/LICENSE_1_0.txt
 ///
+module;
+
+#if __has_include(<sys/inotify.h>) && __has_include(<unistd.h>)
+#include <sys/inotify.h>
+#include <unistd.h>
+#define EAGINE_APP_HAS_INOTIFY 1
+#else
+#define EAGINE_APP_HAS_INOTIFY 0
+#endif
+
 module eagine.app.resource_provider;
 
 import eagine.core;
@@ -17,7 +27,9 @@ namespace eagine::app {
 //------------------------------------------------------------------------------
 class file_io final : public msgbus::source_blob_io {
 public:
-    file_io(std::filesystem::path path);
+    file_io(std::shared_ptr<shared_file> file) noexcept;
+
+    auto prepare() noexcept -> msgbus::blob_preparation_result final;
 
     auto total_size() noexcept -> span_size_t final;
 
@@ -25,25 +37,261 @@ public:
       -> span_size_t final;
 
 private:
-    std::ifstream _file;
-    span_size_t _size{0};
+    std::shared_ptr<shared_file> _file;
 };
 //------------------------------------------------------------------------------
-file_io::file_io(std::filesystem::path path)
-  : _file{path} {
-    _file.seekg(0, std::ios::end);
-    _size = static_cast<span_size_t>(_file.tellg());
+file_io::file_io(std::shared_ptr<shared_file> file) noexcept
+  : _file{std::move(file)} {}
+//------------------------------------------------------------------------------
+// A file that cannot be opened fails the request instead of being served
+// as a blob of the indexed size with no readable content.
+auto file_io::prepare() noexcept -> msgbus::blob_preparation_result {
+    if(not _file->is_open()) {
+        return {msgbus::blob_preparation_status::failed};
+    }
+    return msgbus::blob_preparation_result::finished();
 }
 //------------------------------------------------------------------------------
 auto file_io::total_size() noexcept -> span_size_t {
-    return _size;
+    return _file->size();
 }
 //------------------------------------------------------------------------------
 auto file_io::fetch_fragment(span_size_t offs, memory::block dst) noexcept
   -> span_size_t {
-    _file.seekg(offs, std::ios::beg);
-    return limit_cast<span_size_t>(
-      read_from_stream(_file, head(dst, _size - offs)).gcount());
+    return _file->read(offs, dst);
+}
+//------------------------------------------------------------------------------
+// filesystem_path_index
+//------------------------------------------------------------------------------
+struct filesystem_index_entry {
+    std::filesystem::path path;
+    span_size_t size{0};
+    std::filesystem::file_time_type modified{};
+};
+//------------------------------------------------------------------------------
+class filesystem_path_index : public main_ctx_object {
+public:
+    filesystem_path_index(
+      main_ctx_parent parent,
+      std::filesystem::path prefix,
+      bool allow_symlinks,
+      bool watch_changes) noexcept;
+    filesystem_path_index(filesystem_path_index&&) = delete;
+    filesystem_path_index(const filesystem_path_index&) = delete;
+    auto operator=(filesystem_path_index&&) = delete;
+    auto operator=(const filesystem_path_index&) = delete;
+    ~filesystem_path_index() noexcept;
+
+    auto update() noexcept -> bool;
+
+    auto find(const std::string& relative) const noexcept
+      -> optional_reference<const filesystem_index_entry>;
+
+    void for_each_relative(
+      callable_ref<void(const std::string&) noexcept>) const noexcept;
+
+private:
+    void _rescan() noexcept;
+    void _scan(const std::filesystem::path&) noexcept;
+    void _insert(const std::filesystem::path&) noexcept;
+    void _remove(const std::filesystem::path&) noexcept;
+    auto _relative(const std::filesystem::path&) const -> std::string;
+    void _add_watch(const std::filesystem::path&) noexcept;
+
+    const std::filesystem::path _prefix;
+    const bool _allow_symlinks;
+    std::unordered_map<std::string, filesystem_index_entry> _entries;
+    std::map<int, std::filesystem::path> _watches;
+    int _inotify_fd{-1};
+};
+//------------------------------------------------------------------------------
+filesystem_path_index::filesystem_path_index(
+  main_ctx_parent parent,
+  std::filesystem::path prefix,
+  bool allow_symlinks,
+  bool watch_changes) noexcept
+  : main_ctx_object{"FsPathIdx", parent}
+  , _prefix{std::move(prefix)}
+  , _allow_symlinks{allow_symlinks} {
+#if EAGINE_APP_HAS_INOTIFY
+    if(watch_changes) {
+        _inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(_inotify_fd < 0) {
+            log_warning("failed to start watching '${path}' for changes")
+              .arg("path", "FsPath", _prefix.string());
+        }
+    }
+#else
+    (void)watch_changes;
+#endif
+    _rescan();
+}
+//------------------------------------------------------------------------------
+filesystem_path_index::~filesystem_path_index() noexcept {
+#if EAGINE_APP_HAS_INOTIFY
+    if(_inotify_fd >= 0) {
+        ::close(_inotify_fd);
+    }
+#endif
+}
+//------------------------------------------------------------------------------
+auto filesystem_path_index::_relative(const std::filesystem::path& path) const
+  -> std::string {
+    return path.lexically_relative(_prefix).generic_string();
+}
+//------------------------------------------------------------------------------
+void filesystem_path_index::_add_watch(
+  [[maybe_unused]] const std::filesystem::path& path) noexcept {
+#if EAGINE_APP_HAS_INOTIFY
+    if(_inotify_fd >= 0) {
+        const auto wd{::inotify_add_watch(
+          _inotify_fd,
+          path.c_str(),
+          IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE |
+            IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF)};
+        if(wd >= 0) {
+            _watches[wd] = path;
+        } else {
+            log_warning("failed to watch '${path}' for changes")
+              .arg("path", "FsPath", path.string());
+        }
+    }
+#endif
+}
+//------------------------------------------------------------------------------
+void filesystem_path_index::_insert(const std::filesystem::path& path) noexcept {
+    std::error_code error{};
+    filesystem_index_entry entry{.path = path};
+    entry.size = limit_cast<span_size_t>(std::filesystem::file_size(path, error));
+    if(not error) {
+        entry.modified = std::filesystem::last_write_time(path, error);
+        _entries.insert_or_assign(_relative(path), std::move(entry));
+    }
+}
+//------------------------------------------------------------------------------
+void filesystem_path_index::_scan(const std::filesystem::path& path) noexcept {
+    std::error_code error{};
+    if(_allow_symlinks or not std::filesystem::is_symlink(path, error)) {
+        if(std::filesystem::is_regular_file(path, error)) {
+            _insert(path);
+        } else if(std::filesystem::is_directory(path, error)) {
+            _add_watch(path);
+            for(const auto& dir_entry :
+                std::filesystem::directory_iterator{path, error}) {
+                _scan(dir_entry.path());
+            }
+        }
+    }
+}
+//------------------------------------------------------------------------------
+void filesystem_path_index::_remove(const std::filesystem::path& path) noexcept {
+    const auto relative{_relative(path)};
+    const auto dir_prefix{relative + "/"};
+    std::erase_if(_entries, [&](const auto& p) {
+        return (p.first == relative) or p.first.starts_with(dir_prefix);
+    });
+    std::erase_if(_watches, [&](const auto& p) {
+        const auto watched{_relative(p.second)};
+        if((watched == relative) or watched.starts_with(dir_prefix)) {
+#if EAGINE_APP_HAS_INOTIFY
+            ::inotify_rm_watch(_inotify_fd, p.first);
+#endif
+            return true;
+        }
+        return false;
+    });
+}
+//------------------------------------------------------------------------------
+void filesystem_path_index::_rescan() noexcept {
+    const auto start{std::chrono::steady_clock::now()};
+#if EAGINE_APP_HAS_INOTIFY
+    for(const auto& p : _watches) {
+        ::inotify_rm_watch(_inotify_fd, p.first);
+    }
+#endif
+    _watches.clear();
+    _entries.clear();
+    _scan(_prefix);
+    log_stat("indexed ${count} files in '${path}' in ${interval}")
+      .tag("fsIdxScan")
+      .arg("count", span_size(_entries.size()))
+      .arg("path", "FsPath", _prefix.string())
+      .arg("interval", std::chrono::steady_clock::now() - start);
+}
+//------------------------------------------------------------------------------
+auto filesystem_path_index::update() noexcept -> bool {
+    bool changed{false};
+#if EAGINE_APP_HAS_INOTIFY
+    if(_inotify_fd >= 0) {
+        alignas(::inotify_event) std::array<char, 16 * 1024> buf;
+        while(true) {
+            const auto len{::read(_inotify_fd, buf.data(), buf.size())};
+            if(len <= 0) {
+                break;
+            }
+            changed = true;
+            bool overflow{false};
+            for(const char* ptr{buf.data()}; ptr < buf.data() + len;) {
+                const auto& event{
+                  *reinterpret_cast<const ::inotify_event*>(ptr)};
+                ptr += sizeof(::inotify_event) + event.len;
+
+                if(event.mask & IN_Q_OVERFLOW) {
+                    overflow = true;
+                    continue;
+                }
+                const auto pos{_watches.find(event.wd)};
+                if(pos == _watches.end()) {
+                    continue;
+                }
+                if(event.mask & IN_IGNORED) {
+                    _watches.erase(pos);
+                    continue;
+                }
+                if(event.len == 0) {
+                    if(event.mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                        const auto dir{pos->second};
+                        if(dir == _prefix) {
+                            overflow = true;
+                        } else {
+                            _remove(dir);
+                        }
+                    }
+                    continue;
+                }
+                const auto path{pos->second / event.name};
+                if(event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    _remove(path);
+                }
+                if(event.mask & (IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE)) {
+                    _scan(path);
+                } else if(event.mask & IN_ATTRIB) {
+                    _remove(path);
+                    _scan(path);
+                }
+            }
+            if(overflow) {
+                _rescan();
+            }
+        }
+    }
+#endif
+    return changed;
+}
+//------------------------------------------------------------------------------
+auto filesystem_path_index::find(const std::string& relative) const noexcept
+  -> optional_reference<const filesystem_index_entry> {
+    if(const auto pos{_entries.find(relative)}; pos != _entries.end()) {
+        return {pos->second};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+void filesystem_path_index::for_each_relative(
+  callable_ref<void(const std::string&) noexcept> callback) const noexcept {
+    for(const auto& entry : _entries) {
+        callback(entry.first);
+    }
 }
 //------------------------------------------------------------------------------
 // provider
@@ -63,125 +311,108 @@ public:
       callable_ref<void(string_view) noexcept>) noexcept final;
 
 private:
-    auto _has_resource(
-      const std::filesystem::path&,
-      const std::filesystem::path&,
-      const url& locator) noexcept -> bool;
+    void _update_indices() noexcept;
 
-    auto _get_resource_io(
-      const std::filesystem::path&,
-      const std::filesystem::path&,
-      const url& locator) noexcept -> shared_holder<msgbus::source_blob_io>;
+    auto _find(const url& locator) noexcept
+      -> optional_reference<const filesystem_index_entry>;
 
-    void _for_each_locator(
-      const std::filesystem::path&,
-      const std::filesystem::path&,
-      callable_ref<void(string_view) noexcept>) noexcept;
+    auto _get_shared(const filesystem_index_entry&) noexcept
+      -> std::shared_ptr<shared_file>;
 
     std::string _hostname;
     application_config_value<bool> _allow_symlinks;
+    application_config_value<bool> _watch_changes;
     filesystem_search_paths _search_paths;
+    std::vector<unique_holder<filesystem_path_index>> _indices;
+    std::map<std::filesystem::path, std::weak_ptr<shared_file>> _shared_files;
 };
 //------------------------------------------------------------------------------
 file_provider::file_provider(const provider_parameters& params)
   : main_ctx_object{"FilePrvdr", params.parent}
   , _allow_symlinks{*this, "application.resource_provider.allow_symlinks", false}
-  , _search_paths{"FilSrchPth", as_parent()} {}
-//------------------------------------------------------------------------------
-auto file_provider::_has_resource(
-  const std::filesystem::path& prefix,
-  const std::filesystem::path& path,
-  const url& locator) noexcept -> bool {
-    if(_allow_symlinks or not std::filesystem::is_symlink(path)) {
-        if(std::filesystem::is_regular_file(path)) {
-            std::error_code error{};
-            const auto relative{std::filesystem::relative(path, prefix, error)};
-            if(not error) {
-                if(locator.has_path(relative.string())) {
-                    return true;
-                }
-            }
-        } else if(std::filesystem::is_directory(path)) {
-            for(auto const& dir_entry :
-                std::filesystem::directory_iterator{path}) {
-                if(_has_resource(prefix, dir_entry, locator)) {
-                    return true;
-                }
-            }
-        }
+  , _watch_changes{*this, "application.resource_provider.watch_files", true}
+  , _search_paths{"FilSrchPth", as_parent()} {
+    _indices.reserve(_search_paths.size());
+    for(const auto& search_path : _search_paths) {
+        _indices.emplace_back(
+          hold<filesystem_path_index>,
+          as_parent(),
+          search_path,
+          _allow_symlinks.value(),
+          _watch_changes.value());
     }
-    return false;
 }
 //------------------------------------------------------------------------------
-auto file_provider::has_resource(const url& locator) noexcept -> bool {
-    for(const auto& search_path : _search_paths) {
-        if(_has_resource(search_path, search_path, locator)) {
-            return true;
-        }
+void file_provider::_update_indices() noexcept {
+    for(const auto& index : _indices) {
+        index->update();
     }
-    return false;
 }
 //------------------------------------------------------------------------------
-auto file_provider::_get_resource_io(
-  const std::filesystem::path& prefix,
-  const std::filesystem::path& path,
-  const url& locator) noexcept -> shared_holder<msgbus::source_blob_io> {
-    if(_allow_symlinks or not std::filesystem::is_symlink(path)) {
-        if(std::filesystem::is_regular_file(path)) {
-            std::error_code error{};
-            const auto relative{std::filesystem::relative(path, prefix, error)};
-            if(not error) {
-                if(locator.has_path(relative.string())) {
-                    return {hold<file_io>, path};
+auto file_provider::_find(const url& locator) noexcept
+  -> optional_reference<const filesystem_index_entry> {
+    if(locator) {
+        _update_indices();
+        std::string relative;
+        for(const auto entry : locator.path()) {
+            if(not entry.empty()) {
+                if(not relative.empty()) {
+                    relative.append("/");
                 }
+                append_to(entry, relative);
             }
-        } else if(std::filesystem::is_directory(path)) {
-            for(auto const& dir_entry :
-                std::filesystem::directory_iterator{path}) {
-                if(auto io{_get_resource_io(prefix, dir_entry, locator)}) {
-                    return io;
-                }
+        }
+        for(const auto& index : _indices) {
+            if(auto found{index->find(relative)}) {
+                return found;
             }
         }
     }
     return {};
 }
 //------------------------------------------------------------------------------
-auto file_provider::get_resource_io(const url& locator)
-  -> shared_holder<msgbus::source_blob_io> {
-    for(const auto& search_path : _search_paths) {
-        if(auto io{_get_resource_io(search_path, search_path, locator)}) {
-            return io;
+auto file_provider::_get_shared(const filesystem_index_entry& entry) noexcept
+  -> std::shared_ptr<shared_file> {
+    auto& cached{_shared_files[entry.path]};
+    if(auto file{cached.lock()}) {
+        if(file->is_same(entry.size, entry.modified)) {
+            return file;
         }
     }
-    return {};
+    std::erase_if(_shared_files, [](const auto& p) {
+        return p.second.expired();
+    });
+    auto file{
+      std::make_shared<shared_file>(entry.path, entry.size, entry.modified)};
+    if(file->is_open()) {
+        _shared_files[entry.path] = file;
+    } else {
+        log_error("failed to open resource file ${path}")
+          .arg("path", "FsPath", entry.path.string());
+    }
+    return file;
 }
 //------------------------------------------------------------------------------
-void file_provider::_for_each_locator(
-  const std::filesystem::path& prefix,
-  const std::filesystem::path& path,
-  callable_ref<void(string_view) noexcept> callback) noexcept {
-    if(_allow_symlinks or not std::filesystem::is_symlink(path)) {
-        if(std::filesystem::is_regular_file(path)) {
-            std::error_code error{};
-            const auto relative{std::filesystem::relative(path, prefix, error)};
-            if(not error) {
-                callback(
-                  std::format("file://{}/{}", _hostname, relative.string()));
-            }
-        } else if(std::filesystem::is_directory(path)) {
-            for(auto const& dir_entry :
-                std::filesystem::directory_iterator{path}) {
-                _for_each_locator(prefix, dir_entry, callback);
-            }
-        }
+auto file_provider::has_resource(const url& locator) noexcept -> bool {
+    return _find(locator).has_value();
+}
+//------------------------------------------------------------------------------
+auto file_provider::get_resource_io(const url& locator)
+  -> shared_holder<msgbus::source_blob_io> {
+    if(const auto found{_find(locator)}) {
+        return {hold<file_io>, _get_shared(*found)};
     }
+    return {};
 }
 //------------------------------------------------------------------------------
 void file_provider::for_each_locator(
   callable_ref<void(string_view) noexcept> callback) noexcept {
-    for(const auto& search_path : _search_paths) {
-        _for_each_locator(search_path, search_path, callback);
+    _update_indices();
+    const auto wrapped_callback{[&](const std::string& relative) noexcept {
+        callback(std::format("file://{}/{}", _hostname, relative));
+    }};
+    for(const auto& index : _indices) {
+        index->for_each_relative({construct_from, wrapped_callback});
     }
 }
 //------------------------------------------------------------------------------
@@ -17,10 +17,19 @@ import :driver;
 
 namespace eagine::app {
 //------------------------------------------------------------------------------
+class gl_rendered_blob_context_pool;
 struct gl_rendered_blob_params {
     valid_if_nonnegative<span_size_t> device_index{-1};
     valid_if_positive<int> surface_width{0};
     valid_if_positive<int> surface_height{0};
+    blob_compression compression{};
+    shared_holder<gl_rendered_blob_context_pool> contexts{};
+    // number of GL contexts among which the rendering is split
+    valid_if_positive<int> context_count{1};
+    // range of the parts of the blob rendered by a single context,
+    // the end part is negative if all remaining parts should be rendered
+    int first_part{0};
+    int end_part{-1};
 };
 //------------------------------------------------------------------------------
 struct egl_rendered_blob_context {
@@ -42,6 +51,11 @@ public:
       const eglplus::surface_attributes,
       const eglplus::context_attributes) noexcept -> egl_rendered_blob_context;
 
+    /// @brief Indicates if an EGL display usable for GL rendering is available.
+    static auto has_display(
+      const shared_provider_objects&,
+      const gl_rendered_blob_params&) noexcept -> bool;
+
     egl_context_handler(
       const shared_provider_objects&,
       egl_rendered_blob_context) noexcept;
@@ -59,6 +73,12 @@ private:
     eglplus::owned_context_handle _context;
 };
 //------------------------------------------------------------------------------
+struct gl_cached_texture {
+    oglplus::texture_name name{};
+    int width{0};
+    int height{0};
+};
+//------------------------------------------------------------------------------
 class gl_rendered_blob_context : public main_ctx_object {
 public:
     gl_rendered_blob_context(
@@ -85,6 +105,26 @@ public:
 
     auto make_current() const noexcept -> bool;
 
+    /// @brief Returns the named program linked in this context.
+    /// @details The program is built by the specified function only the first
+    /// time it is requested, so uniforms should be set after each request.
+    auto program(
+      string_view name,
+      callable_ref<oglplus::program_object() noexcept> build) noexcept
+      -> oglplus::program_name;
+
+    /// @brief Returns the texture cached in this context with the given key.
+    auto cached_texture(string_view key) noexcept
+      -> std::optional<gl_cached_texture>;
+
+    /// @brief Keeps the texture in this context for reuse by subsequent blobs.
+    /// @details Only a few most recently used textures are kept.
+    auto cache_texture(
+      string_view key,
+      oglplus::texture_object,
+      int width,
+      int height) noexcept -> gl_cached_texture;
+
 private:
     void _enable_debug() noexcept;
     void _init_fbo(const gl_rendered_blob_params&) noexcept;
@@ -93,6 +133,47 @@ private:
     loaded_resource_context _resource_context;
     oglplus::renderbuffer_object _color_rbo;
     oglplus::framebuffer_object _offscreen_fbo;
+    std::map<std::string, oglplus::program_object, std::less<>> _programs;
+    struct texture_entry {
+        oglplus::texture_object texture;
+        gl_cached_texture info;
+        std::list<std::string>::iterator lru_pos;
+    };
+    static constexpr const std::size_t _max_textures{8U};
+    std::map<std::string, texture_entry, std::less<>> _textures;
+    // the keys of the cached textures, most recently used first
+    std::list<std::string> _texture_lru;
+};
+//------------------------------------------------------------------------------
+/// @brief Pool of idle GL contexts reused by subsequent rendered blobs.
+/// @details The contexts are keyed by the rendering device and surface size.
+class gl_rendered_blob_context_pool : public main_ctx_object {
+public:
+    gl_rendered_blob_context_pool(main_ctx_parent parent) noexcept;
+    gl_rendered_blob_context_pool(gl_rendered_blob_context_pool&&) = delete;
+    gl_rendered_blob_context_pool(const gl_rendered_blob_context_pool&) =
+      delete;
+    auto operator=(gl_rendered_blob_context_pool&&) = delete;
+    auto operator=(const gl_rendered_blob_context_pool&) = delete;
+    ~gl_rendered_blob_context_pool() noexcept;
+
+    /// @brief Returns an idle context matching the parameters, made current.
+    auto acquire(const gl_rendered_blob_params&) noexcept
+      -> shared_holder<gl_rendered_blob_context>;
+
+    /// @brief Returns a context that is no longer used into the pool.
+    void release(
+      const gl_rendered_blob_params&,
+      shared_holder<gl_rendered_blob_context>) noexcept;
+
+private:
+    using key_type = std::tuple<span_size_t, int, int>;
+    static auto _key_of(const gl_rendered_blob_params&) noexcept -> key_type;
+    void _drop_oldest() noexcept;
+
+    application_config_value<span_size_t> _max_idle;
+    std::deque<std::pair<key_type, shared_holder<gl_rendered_blob_context>>>
+      _idle;
 };
 //------------------------------------------------------------------------------
 class gl_rendered_source_blob_io;
@@ -121,6 +202,21 @@ protected:
     void compress(const memory::const_block) noexcept;
     void compress(const string_view) noexcept;
     void compress(const byte) noexcept;
+    void compress_part(span_size_t part, const memory::const_block) noexcept;
+
+    auto program(
+      string_view name,
+      callable_ref<oglplus::program_object() noexcept> build) noexcept
+      -> oglplus::program_name;
+
+    auto cached_texture(string_view key) noexcept
+      -> std::optional<gl_cached_texture>;
+
+    auto cache_texture(
+      string_view key,
+      oglplus::texture_object,
+      int width,
+      int height) noexcept -> gl_cached_texture;
 
 private:
     gl_rendered_source_blob_io& _parent;
@@ -144,8 +240,8 @@ protected:
         return oglplus::vertex_attrib_location{0};
     }
 
-    auto _init_program(oglplus::program_object prog) noexcept {
-        _prog = std::move(prog);
+    auto _init_program(oglplus::program_name prog) noexcept {
+        _prog = prog;
     }
 
     virtual auto prepare_render() noexcept -> msgbus::blob_preparation_result;
@@ -159,26 +255,54 @@ protected:
     }
 
 private:
+    // Pixel pack buffer into which a rendered cube face is read back
+    // asynchronously and the fence signalled when the read has finished.
+    struct face_readback {
+        oglplus::buffer_object pack_buffer;
+        oglplus::owned_sync read_done;
+    };
+
     auto _build_screen() noexcept -> oglplus::geometry_and_bindings;
-    void _render_tile() noexcept;
+    auto _init_readbacks() noexcept -> bool;
+    auto _render_tile() noexcept -> bool;
+    auto _has_budget_for_tile(
+      std::chrono::steady_clock::time_point batch_start) const noexcept -> bool;
+    void _render_batch() noexcept;
+    void _update_pixel_cost() noexcept;
+    void _read_cube_face() noexcept;
+    auto _save_read_cube_face() noexcept -> bool;
     void _save_cube_face() noexcept;
 
-    auto _done_tiles() const noexcept -> span_size_t;
-    auto _total_tiles() const noexcept -> span_size_t;
+    auto _done_pixels() const noexcept -> span_size_t;
+    auto _total_pixels() const noexcept -> span_size_t;
+    auto _face_bytes() const noexcept -> span_size_t;
 
     main_ctx_buffer _buffer;
 
     const std::chrono::steady_clock::time_point _start{
       std::chrono::steady_clock::now()};
     const oglplus::geometry_and_bindings _screen;
-    oglplus::program_object _prog;
+    oglplus::program_name _prog;
     const int _size;
-    const int _tile_size;
-    const int _tiles_per_side{1};
+    const int _first_face;
+    const int _end_face;
+    const std::chrono::steady_clock::duration _render_budget;
+    // side of the tiles, adjusted to the measured rendering cost
+    int _tile_size;
+    // the tile size used in the current row of tiles
+    int _row_height{0};
     int _tile_x{0};
     int _tile_y{0};
-    int _face_index{0};
+    int _face_index;
+    int _saved_faces;
+    // estimated GPU time in nanoseconds needed to render a single pixel
+    float _pixel_cost{0.F};
+    span_size_t _batch_pixels{0};
+    std::chrono::steady_clock::time_point _batch_start;
+    oglplus::owned_sync _batch_done;
     oglplus::owned_sync _finishing_face;
+    std::array<face_readback, 2> _readbacks;
+    const bool _use_readbacks{false};
 
     activity_progress _prepare_progress;
 };
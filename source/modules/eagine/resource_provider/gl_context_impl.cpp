@@ -127,6 +127,16 @@ auto egl_context_handler::create_context(
     return {};
 }
 //------------------------------------------------------------------------------
+auto egl_context_handler::has_display(
+  const shared_provider_objects& shared,
+  const gl_rendered_blob_params& params) noexcept -> bool {
+    if(auto display{egl_context_handler_open_display(shared, params)}) {
+        display.clean_up();
+        return true;
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
 egl_context_handler::egl_context_handler(
   const shared_provider_objects& shared,
   egl_rendered_blob_context context) noexcept
@@ -274,6 +284,128 @@ auto gl_rendered_blob_context::gl_api() const noexcept
     return _resource_context.gl_api();
 }
 //------------------------------------------------------------------------------
+auto gl_rendered_blob_context::program(
+  string_view name,
+  callable_ref<oglplus::program_object() noexcept> build) noexcept
+  -> oglplus::program_name {
+    if(const auto pos{_programs.find(name)}; pos != _programs.end()) {
+        return pos->second;
+    }
+    try {
+        auto& prog{_programs[to_string(name)] = build()};
+        log_debug("built program ${name}").arg("name", name);
+        return prog;
+    } catch(...) {
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+auto gl_rendered_blob_context::cached_texture(string_view key) noexcept
+  -> std::optional<gl_cached_texture> {
+    if(const auto pos{_textures.find(key)}; pos != _textures.end()) {
+        _texture_lru.splice(
+          _texture_lru.begin(), _texture_lru, pos->second.lru_pos);
+        return pos->second.info;
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+auto gl_rendered_blob_context::cache_texture(
+  string_view key,
+  oglplus::texture_object tex,
+  int width,
+  int height) noexcept -> gl_cached_texture {
+    const gl_cached_texture result{
+      .name = tex, .width = width, .height = height};
+    try {
+        if(const auto pos{_textures.find(key)}; pos != _textures.end()) {
+            _texture_lru.erase(pos->second.lru_pos);
+            _textures.erase(pos);
+        }
+        _texture_lru.emplace_front(to_string(key));
+        _textures[to_string(key)] = {
+          .texture = std::move(tex),
+          .info = result,
+          .lru_pos = _texture_lru.begin()};
+        // the least recently used textures are deleted, this does not affect
+        // the texture just cached, used by the current renderer
+        while(_texture_lru.size() > _max_textures) {
+            _textures.erase(_texture_lru.back());
+            _texture_lru.pop_back();
+        }
+        log_debug("cached texture ${key}")
+          .arg("key", key)
+          .arg("width", width)
+          .arg("height", height);
+        return result;
+    } catch(...) {
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+// gl_rendered_blob_context_pool
+//------------------------------------------------------------------------------
+gl_rendered_blob_context_pool::gl_rendered_blob_context_pool(
+  main_ctx_parent parent) noexcept
+  : main_ctx_object{"GLRBCtxPol", parent}
+  , _max_idle{
+      main_context().config(),
+      "application.resource_provider.gl_context_pool_size",
+      span_size(2)} {}
+//------------------------------------------------------------------------------
+gl_rendered_blob_context_pool::~gl_rendered_blob_context_pool() noexcept {
+    while(not _idle.empty()) {
+        _drop_oldest();
+    }
+}
+//------------------------------------------------------------------------------
+// The GL objects owned by the context are deleted in the current context,
+// so the dropped context has to be made current first.
+void gl_rendered_blob_context_pool::_drop_oldest() noexcept {
+    _idle.front().second->make_current();
+    _idle.pop_front();
+}
+//------------------------------------------------------------------------------
+auto gl_rendered_blob_context_pool::_key_of(
+  const gl_rendered_blob_params& params) noexcept -> key_type {
+    return {
+      params.device_index.value_or(-1),
+      params.surface_width.value_or(0),
+      params.surface_height.value_or(0)};
+}
+//------------------------------------------------------------------------------
+auto gl_rendered_blob_context_pool::acquire(
+  const gl_rendered_blob_params& params) noexcept
+  -> shared_holder<gl_rendered_blob_context> {
+    const auto key{_key_of(params)};
+    const auto pos{std::find_if(_idle.begin(), _idle.end(), [&](auto& entry) {
+        return entry.first == key;
+    })};
+    if(pos != _idle.end()) {
+        auto context{std::move(pos->second)};
+        _idle.erase(pos);
+        if(context->make_current()) {
+            log_debug("reusing pooled GL context");
+            return context;
+        }
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+void gl_rendered_blob_context_pool::release(
+  const gl_rendered_blob_params& params,
+  shared_holder<gl_rendered_blob_context> context) noexcept {
+    if(context and (_max_idle.value() > 0)) {
+        try {
+            _idle.emplace_back(_key_of(params), std::move(context));
+            while(span_size(_idle.size()) > _max_idle.value()) {
+                _drop_oldest();
+            }
+        } catch(...) {
+        }
+    }
+}
+//------------------------------------------------------------------------------
 // gl_blob_renderer
 //------------------------------------------------------------------------------
 gl_blob_renderer::gl_blob_renderer(
@@ -341,6 +473,32 @@ void gl_blob_renderer::compress(const byte b) noexcept {
     _parent.compress(b);
 }
 //------------------------------------------------------------------------------
+void gl_blob_renderer::compress_part(
+  span_size_t part,
+  const memory::const_block b) noexcept {
+    _parent.compress_part(part, b);
+}
+//------------------------------------------------------------------------------
+auto gl_blob_renderer::program(
+  string_view name,
+  callable_ref<oglplus::program_object() noexcept> build) noexcept
+  -> oglplus::program_name {
+    return _gl_context->program(name, build);
+}
+//------------------------------------------------------------------------------
+auto gl_blob_renderer::cached_texture(string_view key) noexcept
+  -> std::optional<gl_cached_texture> {
+    return _gl_context->cached_texture(key);
+}
+//------------------------------------------------------------------------------
+auto gl_blob_renderer::cache_texture(
+  string_view key,
+  oglplus::texture_object tex,
+  int width,
+  int height) noexcept -> gl_cached_texture {
+    return _gl_context->cache_texture(key, std::move(tex), width, height);
+}
+//------------------------------------------------------------------------------
 // eagitexi_cubemap_renderer
 //------------------------------------------------------------------------------
 auto eagitexi_cubemap_renderer::_build_screen() noexcept
@@ -355,6 +513,15 @@ auto eagitexi_cubemap_renderer::_build_screen() noexcept
     return screen;
 }
 //------------------------------------------------------------------------------
+static auto cubemap_render_budget(main_ctx_object& renderer) noexcept
+  -> std::chrono::steady_clock::duration {
+    if(const auto budget{renderer.app_config().get<std::chrono::microseconds>(
+         "application.resource_provider.cubemap_render_budget")}) {
+        return std::max(*budget, std::chrono::microseconds{100});
+    }
+    return std::chrono::milliseconds{10};
+}
+//------------------------------------------------------------------------------
 eagitexi_cubemap_renderer::eagitexi_cubemap_renderer(
   gl_rendered_source_blob_io& parent,
   string_view progress_label,
@@ -366,18 +533,44 @@ eagitexi_cubemap_renderer::eagitexi_cubemap_renderer(
   , _buffer{*this, size * size * 4, nothing}
   , _screen{_build_screen()}
   , _size{size}
-  , _tile_size{tile_size}
-  , _tiles_per_side{std::max(_size / _tile_size, 1)}
+  , _first_face{std::clamp(params.first_part, 0, 6)}
+  , _end_face{
+      params.end_part < 0 ? 6 : std::clamp(params.end_part, _first_face, 6)}
+  , _render_budget{cubemap_render_budget(*this)}
+  , _tile_size{std::clamp(tile_size, 1, size)}
+  , _face_index{_first_face}
+  , _saved_faces{_first_face}
+  , _use_readbacks{_init_readbacks()}
   , _prepare_progress{
       main_context().progress(),
       progress_label,
-      _total_tiles()} {
+      _total_pixels()} {
     const auto& [gl, GL]{gl_api()};
     gl.viewport(0, 0, _size, _size);
     gl.disable(GL.depth_test);
 }
 //------------------------------------------------------------------------------
-void eagitexi_cubemap_renderer::_render_tile() noexcept {
+auto eagitexi_cubemap_renderer::_init_readbacks() noexcept -> bool {
+    const auto& [gl, GL]{gl_api()};
+    if(not(gl.map_buffer_range and gl.unmap_buffer)) {
+        log_info("pixel pack buffers are not available")
+          .tag("cmTxRdBack");
+        return false;
+    }
+    _buffer.resize(_face_bytes());
+    for(auto& readback : _readbacks) {
+        readback.pack_buffer = gl_api().create_buffer_object();
+        gl.bind_buffer(GL.pixel_pack_buffer, readback.pack_buffer);
+        gl.buffer_data(GL.pixel_pack_buffer, view(_buffer), GL.stream_read);
+    }
+    gl.bind_buffer(GL.pixel_pack_buffer, oglplus::buffer_name{});
+    return true;
+}
+//------------------------------------------------------------------------------
+// Renders the next tile of the current face and returns true if that was
+// the last tile of the face. The tile size can change between rows of tiles,
+// the tiles at the right and at the top edge of the face are clipped.
+auto eagitexi_cubemap_renderer::_render_tile() noexcept -> bool {
     const auto& glapi{gl_api()};
     const auto& [gl, GL]{glapi};
     if((_tile_x == 0) and (_tile_y == 0)) {
@@ -386,15 +579,134 @@ void eagitexi_cubemap_renderer::_render_tile() noexcept {
         gl.clear(GL.color_buffer_bit);
         glapi.try_set_uniform(_prog, "faceIdx", _face_index);
     }
+    if(_tile_x == 0) {
+        _row_height = std::min(_tile_size, _size - _tile_y);
+    }
+    const auto tile_width{std::min(_row_height, _size - _tile_x)};
     gl.enable(GL.scissor_test);
-    gl.scissor(
-      _tile_x * _tile_size, _tile_y * _tile_size, _tile_size, _tile_size);
+    gl.scissor(_tile_x, _tile_y, tile_width, _row_height);
     _screen.draw(glapi);
+    _batch_pixels += span_size(tile_width) * _row_height;
+
+    if((_tile_x += tile_width) >= _size) {
+        _tile_x = 0;
+        if((_tile_y += _row_height) >= _size) {
+            _tile_y = 0;
+            return true;
+        }
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+auto eagitexi_cubemap_renderer::_has_budget_for_tile(
+  std::chrono::steady_clock::time_point batch_start) const noexcept -> bool {
+    if(_pixel_cost <= 0.F) {
+        // the first batch renders a single tile to measure the cost
+        return false;
+    }
+    if(std::chrono::steady_clock::now() - batch_start >= _render_budget) {
+        return false;
+    }
+    const auto tile_pixels{span_size(_tile_size) * _tile_size};
+    const std::chrono::duration<float, std::nano> gpu_time{
+      float(_batch_pixels + tile_pixels) * _pixel_cost};
+    return gpu_time < _render_budget;
+}
+//------------------------------------------------------------------------------
+// Renders as many tiles as fit into the time budget, according to the cost
+// measured for the previous batches, and inserts a fence after them.
+void eagitexi_cubemap_renderer::_render_batch() noexcept {
+    const auto batch_start{std::chrono::steady_clock::now()};
+    _batch_pixels = 0;
+    do {
+        if(_render_tile()) {
+            if(_use_readbacks) {
+                _read_cube_face();
+                ++_face_index;
+            } else {
+                _finishing_face = gl_api().fence();
+            }
+            break;
+        }
+    } while(_has_budget_for_tile(batch_start));
+    _batch_start = batch_start;
+    _batch_done = gl_api().fence();
+}
+//------------------------------------------------------------------------------
+// Updates the estimated cost of a pixel from the time it took to render
+// the last batch and adjusts the tile size, so that a single tile takes
+// about a quarter of the time budget.
+void eagitexi_cubemap_renderer::_update_pixel_cost() noexcept {
+    if(_batch_pixels <= 0) {
+        return;
+    }
+    const std::chrono::duration<float, std::nano> batch_time{
+      std::chrono::steady_clock::now() - _batch_start};
+    const auto cost{batch_time.count() / float(_batch_pixels)};
+    _pixel_cost = (_pixel_cost > 0.F) ? (_pixel_cost + cost) * 0.5F : cost;
+
+    const std::chrono::duration<float, std::nano> tile_budget{
+      _render_budget / 4};
+    const auto ideal{int(std::min(
+      std::sqrt(tile_budget.count() / _pixel_cost), float(_size)))};
+    _tile_size = std::clamp(
+      ideal, std::max(_tile_size / 2, 1), std::min(_tile_size * 2, _size));
+}
+//------------------------------------------------------------------------------
+// Starts reading the just rendered cube face into the next pack buffer
+// in the ring. The read is queued after the draw commands and the next face
+// can be rendered while it is in progress.
+void eagitexi_cubemap_renderer::_read_cube_face() noexcept {
+    const auto& [gl, GL]{gl_api()};
+    auto& readback{_readbacks[std_size(_face_index) % _readbacks.size()]};
+    assert(not readback.read_done);
+
+    gl.disable(GL.scissor_test);
+    gl.bind_buffer(GL.pixel_pack_buffer, readback.pack_buffer);
+    // with a bound pack buffer the destination is an offset into the buffer
+    gl.read_pixels(
+      0,
+      0,
+      oglplus::gl_types::sizei_type(_size),
+      oglplus::gl_types::sizei_type(_size),
+      GL.rgba,
+      GL.unsigned_byte_,
+      memory::block{});
+    gl.bind_buffer(GL.pixel_pack_buffer, oglplus::buffer_name{});
+    readback.read_done = gl_api().fence();
+}
+//------------------------------------------------------------------------------
+// Compresses the oldest read back cube face, if its read has finished.
+// The faces are saved in the order in which they were rendered.
+auto eagitexi_cubemap_renderer::_save_read_cube_face() noexcept -> bool {
+    auto& readback{_readbacks[std_size(_saved_faces) % _readbacks.size()]};
+    if(not readback.read_done) {
+        return false;
+    }
+    if(not gl_api().client_fence_passed(readback.read_done)) {
+        return false;
+    }
+    const auto& [gl, GL]{gl_api()};
+    gl.bind_buffer(GL.pixel_pack_buffer, readback.pack_buffer);
+    if(const auto mapped{gl.map_buffer_range(
+         GL.pixel_pack_buffer, 0, _face_bytes(), GL.map_read_bit)}) {
+        compress_part(_saved_faces, memory::const_block{*mapped});
+        gl.unmap_buffer(GL.pixel_pack_buffer);
+    } else {
+        log_error("failed to map the cube face pixel pack buffer")
+          .arg("face", _saved_faces);
+        _buffer.resize(_face_bytes());
+        std::fill_n(_buffer.data(), _buffer.size(), byte(0));
+        compress_part(_saved_faces, view(_buffer));
+    }
+    gl.bind_buffer(GL.pixel_pack_buffer, oglplus::buffer_name{});
+    ++_saved_faces;
+    return true;
 }
 //------------------------------------------------------------------------------
 void eagitexi_cubemap_renderer::_save_cube_face() noexcept {
     const auto& [gl, GL]{gl_api()};
-    _buffer.resize(span_size(_size * _size * 4));
+    _buffer.resize(_face_bytes());
 
     gl.disable(GL.scissor_test);
     gl.finish();
@@ -408,16 +720,20 @@ void eagitexi_cubemap_renderer::_save_cube_face() noexcept {
       cover(_buffer));
     gl.finish();
 
-    compress(view(_buffer));
+    compress_part(_face_index, view(_buffer));
+}
+//------------------------------------------------------------------------------
+auto eagitexi_cubemap_renderer::_done_pixels() const noexcept -> span_size_t {
+    return (span_size(_face_index - _first_face) * _size * _size) +
+           (span_size(_tile_y) * _size) + (span_size(_tile_x) * _row_height);
 }
 //------------------------------------------------------------------------------
-auto eagitexi_cubemap_renderer::_done_tiles() const noexcept -> span_size_t {
-    return (_face_index * _tiles_per_side * _tiles_per_side) +
-           (_tile_y * _tiles_per_side) + _tile_x;
+auto eagitexi_cubemap_renderer::_total_pixels() const noexcept -> span_size_t {
+    return span_size(_end_face - _first_face) * _size * _size;
 }
 //------------------------------------------------------------------------------
-auto eagitexi_cubemap_renderer::_total_tiles() const noexcept -> span_size_t {
-    return 6 * _tiles_per_side * _tiles_per_side;
+auto eagitexi_cubemap_renderer::_face_bytes() const noexcept -> span_size_t {
+    return span_size(_size) * _size * 4;
 }
 //------------------------------------------------------------------------------
 auto eagitexi_cubemap_renderer::prepare_render() noexcept
@@ -431,27 +747,34 @@ auto eagitexi_cubemap_renderer::render() noexcept
        not prep_result.has_finished()) {
         return prep_result;
     }
-    if(_face_index < 6) {
-        if(_finishing_face) {
+    if(_saved_faces < _end_face) {
+        // the next batch is rendered only after the previous one finished
+        if(_batch_done and gl_api().client_fence_passed(_batch_done)) {
+            _update_pixel_cost();
+        }
+        if(_use_readbacks) {
+            _save_read_cube_face();
+            // render the next batch, unless all the pack buffers are in use
+            const auto pending{std_size(_face_index - _saved_faces)};
+            if(
+              not _batch_done and (_face_index < _end_face) and
+              (pending < _readbacks.size())) {
+                _render_batch();
+            }
+        } else if(_finishing_face) {
             if(gl_api().client_fence_passed(_finishing_face)) {
                 _save_cube_face();
                 ++_face_index;
+                ++_saved_faces;
             }
-        } else {
-            _render_tile();
-            if(++_tile_x >= _tiles_per_side) {
-                _tile_x = 0;
-                if(++_tile_y >= _tiles_per_side) {
-                    _tile_y = 0;
-                    _finishing_face = gl_api().fence();
-                }
-            }
+        } else if(not _batch_done) {
+            _render_batch();
         }
-        if(_face_index < 6) {
-            _prepare_progress.update_progress(_done_tiles());
+        if(_saved_faces < _end_face) {
+            _prepare_progress.update_progress(_done_pixels());
             return {
-              _done_tiles(),
-              _total_tiles(),
+              _done_pixels(),
+              _total_pixels(),
               msgbus::blob_preparation_status::working};
         } else {
             _prepare_progress.finish();
@@ -459,7 +782,9 @@ auto eagitexi_cubemap_renderer::render() noexcept
     }
     log_stat("cube-map render finished in ${interval}")
       .tag("cmTxRdrTim")
-      .arg("interval", std::chrono::steady_clock::now() - _start);
+      .arg("interval", std::chrono::steady_clock::now() - _start)
+      .arg("tileSize", _tile_size)
+      .arg("pixelCost", _pixel_cost);
     return msgbus::blob_preparation_result::finished();
 }
 //------------------------------------------------------------------------------
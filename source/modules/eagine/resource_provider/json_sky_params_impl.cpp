@@ -151,6 +151,11 @@ public:
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
 
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/sky_parameters");
+    }
+
 private:
     shared_provider_objects& _shared;
 };
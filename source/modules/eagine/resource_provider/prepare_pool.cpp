@@ -0,0 +1,61 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+/// https://www.boost.org/LICENSE_1_0.txt
+///
+export module eagine.app.resource_provider:prepare_pool;
+
+import eagine.core;
+import eagine.msgbus;
+import std;
+
+namespace eagine::app {
+//------------------------------------------------------------------------------
+// blob_prepare_pool
+//------------------------------------------------------------------------------
+/// @brief Pool of worker threads preparing the content of independent blobs.
+/// @details The I/Os handed to the pool must not access any objects shared
+/// with the main thread from their prepare function, once they are ready
+/// for background preparation.
+export class blob_prepare_pool : public main_ctx_object {
+public:
+    blob_prepare_pool(main_ctx_parent parent);
+    blob_prepare_pool(blob_prepare_pool&&) = delete;
+    blob_prepare_pool(const blob_prepare_pool&) = delete;
+    auto operator=(blob_prepare_pool&&) = delete;
+    auto operator=(const blob_prepare_pool&) = delete;
+    ~blob_prepare_pool() noexcept;
+
+    /// @brief Indicates if there are any worker threads.
+    auto has_workers() const noexcept -> bool {
+        return not _workers.empty();
+    }
+
+    /// @brief Returns the number of worker threads.
+    auto worker_count() const noexcept -> span_size_t {
+        return span_size(_workers.size());
+    }
+
+    /// @brief Wraps the I/O so that its prepare function runs in a worker.
+    /// @param ready Called on the main thread, before the preparation is
+    ///        handed to a worker. While it returns false, the I/O is prepared
+    ///        on the main thread.
+    auto prepare_in_background(
+      shared_holder<msgbus::source_blob_io> io,
+      std::function<bool()> ready = {})
+      -> shared_holder<msgbus::source_blob_io>;
+
+    void enqueue(std::function<void(const std::stop_token&)> work);
+
+private:
+    void _run(std::stop_token) noexcept;
+
+    std::mutex _mutex;
+    std::condition_variable_any _cond;
+    std::deque<std::function<void(const std::stop_token&)>> _queue;
+    std::vector<std::jthread> _workers;
+};
+//------------------------------------------------------------------------------
+} // namespace eagine::app
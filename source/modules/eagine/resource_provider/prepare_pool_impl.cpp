@@ -0,0 +1,218 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+/// https://www.boost.org/LICENSE_1_0.txt
+///
+module eagine.app.resource_provider;
+
+import eagine.core;
+import eagine.msgbus;
+import std;
+
+namespace eagine::app {
+//------------------------------------------------------------------------------
+// background_prepare_state
+//------------------------------------------------------------------------------
+// Shared by the wrapping I/O on the main thread and by the work item
+// in the worker, which repeatedly calls the prepare function of the I/O.
+class background_prepare_state {
+public:
+    background_prepare_state(msgbus::source_blob_io& io) noexcept
+      : _io{io} {}
+
+    auto result() noexcept -> msgbus::blob_preparation_result {
+        const std::unique_lock lock{_mutex};
+        return _result;
+    }
+
+    auto is_done() noexcept -> bool {
+        const std::unique_lock lock{_mutex};
+        return _done;
+    }
+
+    void work(const std::stop_token& stop) noexcept;
+
+    void cancel() noexcept {
+        std::unique_lock lock{_mutex};
+        _cancelled = true;
+        _cond.wait(lock, [this] { return not _busy; });
+    }
+
+private:
+    msgbus::source_blob_io& _io;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    msgbus::blob_preparation_result _result{
+      msgbus::blob_preparation_status::working};
+    bool _busy{false};
+    bool _done{false};
+    bool _cancelled{false};
+};
+//------------------------------------------------------------------------------
+void background_prepare_state::work(const std::stop_token& stop) noexcept {
+    while(true) {
+        {
+            const std::unique_lock lock{_mutex};
+            if(_cancelled or stop.stop_requested()) {
+                break;
+            }
+            _busy = true;
+        }
+        const auto result{_io.prepare()};
+        const bool done{
+          result.has_finished() or
+          (result.status() == msgbus::blob_preparation_status::failed)};
+        {
+            const std::unique_lock lock{_mutex};
+            _result = result;
+            _done = done;
+            _busy = false;
+        }
+        _cond.notify_all();
+        if(done) {
+            break;
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// background_prepared_source_blob_io
+//------------------------------------------------------------------------------
+class background_prepared_source_blob_io final : public msgbus::source_blob_io {
+public:
+    background_prepared_source_blob_io(
+      blob_prepare_pool& pool,
+      shared_holder<msgbus::source_blob_io> io,
+      std::function<bool()> ready) noexcept
+      : _pool{pool}
+      , _io{std::move(io)}
+      , _ready{std::move(ready)} {}
+
+    background_prepared_source_blob_io(background_prepared_source_blob_io&&) =
+      delete;
+    background_prepared_source_blob_io(
+      const background_prepared_source_blob_io&) = delete;
+    auto operator=(background_prepared_source_blob_io&&) = delete;
+    auto operator=(const background_prepared_source_blob_io&) = delete;
+
+    ~background_prepared_source_blob_io() noexcept final {
+        // the I/O must not be destroyed while the worker is using it
+        if(_state) {
+            _state->cancel();
+        }
+    }
+
+    auto prepare() noexcept -> msgbus::blob_preparation_result final;
+
+    auto total_size() noexcept -> span_size_t final {
+        return _is_available() ? _io->total_size() : 0;
+    }
+
+    auto fetch_fragment(span_size_t offs, memory::block dst) noexcept
+      -> span_size_t final {
+        return _is_available() ? _io->fetch_fragment(offs, dst) : 0;
+    }
+
+private:
+    auto _is_available() noexcept -> bool {
+        return not _state or _state->is_done();
+    }
+
+    blob_prepare_pool& _pool;
+    shared_holder<msgbus::source_blob_io> _io;
+    std::function<bool()> _ready;
+    std::shared_ptr<background_prepare_state> _state;
+};
+//------------------------------------------------------------------------------
+auto background_prepared_source_blob_io::prepare() noexcept
+  -> msgbus::blob_preparation_result {
+    if(not _state) {
+        if(_ready and not _ready()) {
+            return _io->prepare();
+        }
+        try {
+            _state = std::make_shared<background_prepare_state>(*_io);
+            _pool.enqueue(
+              [state{_state}](const std::stop_token& stop) {
+                  state->work(stop);
+              });
+        } catch(...) {
+            _state.reset();
+            return _io->prepare();
+        }
+    }
+    return _state->result();
+}
+//------------------------------------------------------------------------------
+// blob_prepare_pool
+//------------------------------------------------------------------------------
+static auto blob_prepare_thread_count(main_ctx_object& parent) noexcept
+  -> span_size_t {
+    if(const auto count{parent.app_config().get<span_size_t>(
+         "application.resource_provider.prepare_threads")}) {
+        return std::max(*count, span_size(0));
+    }
+    return std::max(
+      span_size(std::thread::hardware_concurrency()) - 1, span_size(0));
+}
+//------------------------------------------------------------------------------
+blob_prepare_pool::blob_prepare_pool(main_ctx_parent parent)
+  : main_ctx_object{"BlbPrpPool", parent} {
+    const auto count{blob_prepare_thread_count(*this)};
+    _workers.reserve(std_size(count));
+    for(span_size_t i = 0; i < count; ++i) {
+        _workers.emplace_back(
+          [this](std::stop_token stop) { _run(std::move(stop)); });
+    }
+    log_info("started ${count} blob preparation worker threads")
+      .arg("count", count);
+}
+//------------------------------------------------------------------------------
+blob_prepare_pool::~blob_prepare_pool() noexcept {
+    for(auto& worker : _workers) {
+        worker.request_stop();
+    }
+    _cond.notify_all();
+    _workers.clear();
+}
+//------------------------------------------------------------------------------
+void blob_prepare_pool::_run(std::stop_token stop) noexcept {
+    while(true) {
+        std::function<void(const std::stop_token&)> work;
+        {
+            std::unique_lock lock{_mutex};
+            if(not _cond.wait(
+                 lock, stop, [this] { return not _queue.empty(); })) {
+                break;
+            }
+            work = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        work(stop);
+    }
+}
+//------------------------------------------------------------------------------
+void blob_prepare_pool::enqueue(
+  std::function<void(const std::stop_token&)> work) {
+    {
+        const std::unique_lock lock{_mutex};
+        _queue.emplace_back(std::move(work));
+    }
+    _cond.notify_one();
+}
+//------------------------------------------------------------------------------
+auto blob_prepare_pool::prepare_in_background(
+  shared_holder<msgbus::source_blob_io> io,
+  std::function<bool()> ready) -> shared_holder<msgbus::source_blob_io> {
+    if(io and has_workers()) {
+        return {
+          hold<background_prepared_source_blob_io>,
+          *this,
+          std::move(io),
+          std::move(ready)};
+    }
+    return io;
+}
+//------------------------------------------------------------------------------
+} // namespace eagine::app
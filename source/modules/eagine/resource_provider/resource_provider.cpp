@@ -14,6 +14,8 @@ import std;
 
 export import :external_apis;
 export import :gl_context;
+export import :blob_cache;
+export import :prepare_pool;
 export import :driver;
 export import :providers;
 export import :common;
@@ -9,7 +9,8 @@ out vec4 fragColor;
 uniform samplerCube cubeMap;
 uniform int faceIdx;
 uniform int cubeSide;
-uniform int sharpness;
+uniform float sharpness;
+uniform int windowRadius;
 
 mat3 getCubeFace(int f) {
     return mat3[6](
@@ -34,24 +35,53 @@ vec3 getSampleCoord(int f, int x, int y) {
     return face[0] * sampleCoord.x + face[1] * sampleCoord.y + face[2];
 }
 
+float kernelWeight(vec3 cubeCoord, vec3 sampleCubeCoord) {
+    return pow(
+      max(dot(normalize(cubeCoord), normalize(sampleCubeCoord)), 0.0),
+      pow(2.0, sharpness));
+}
+
 void main() {
     vec3 cubeCoord = getCubeCoord();
     vec4 accumColor = vec4(0.0);
     float accumWeight = 0.0;
-    for(int f = 0; f < 6; ++f) {
-        for(int y = 0; y < cubeSide; ++y) {
-            for(int x = 0; x < cubeSide; ++x) {
-                vec3 sampleCubeCoord = getSampleCoord(f, x, y);
+    if(windowRadius > 0) {
+        // only the texels in the window around this one have non-negligible
+        // weights, they are sampled on the plane of this face, extended past
+        // its edges, and weighted by their solid angle
+        mat3 face = getCubeFace(faceIdx);
+        float texelStep = 2.0 / float(cubeSide);
+        for(int y = -windowRadius; y <= windowRadius; ++y) {
+            for(int x = -windowRadius; x <= windowRadius; ++x) {
+                vec2 planeCoord =
+                  vertCoord + vec2(float(x), float(y)) * texelStep;
+                vec3 sampleCubeCoord =
+                  face[0] * planeCoord.x + face[1] * planeCoord.y + face[2];
                 vec4 sampleColor = texture(cubeMap, sampleCubeCoord);
-                float sampleWeight = pow(
-                  max(
-                    dot(normalize(cubeCoord), normalize(sampleCubeCoord)), 0.0),
-                  pow(2.0, float(sharpness)));
+                float sampleWeight =
+                  kernelWeight(cubeCoord, sampleCubeCoord) *
+                  pow(1.0 + dot(planeCoord, planeCoord), -1.5);
                 accumColor = accumColor + sampleColor * sampleWeight;
                 accumWeight += sampleWeight;
             }
         }
+    } else {
+        for(int f = 0; f < 6; ++f) {
+            for(int y = 0; y < cubeSide; ++y) {
+                for(int x = 0; x < cubeSide; ++x) {
+                    vec3 sampleCubeCoord = getSampleCoord(f, x, y);
+                    vec4 sampleColor = texture(cubeMap, sampleCubeCoord);
+                    float sampleWeight =
+                      kernelWeight(cubeCoord, sampleCubeCoord);
+                    accumColor = accumColor + sampleColor * sampleWeight;
+                    accumWeight += sampleWeight;
+                }
+            }
+        }
+    }
+    if(accumWeight > 0.0) {
+        fragColor = accumColor / accumWeight;
+    } else {
+        fragColor = texture(cubeMap, cubeCoord);
     }
-    fragColor = accumColor / accumWeight;
 }
-
@@ -30,6 +30,19 @@ public:
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
 
+    auto is_blob_cacheable(const url&) noexcept -> bool final {
+        return true;
+    }
+
+    auto blob_cache_salt(const url&) noexcept -> std::string final {
+        return "shape1";
+    }
+
+    void for_each_served_scheme(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("shape");
+    }
+
 private:
     std::string _domain;
 };
@@ -67,6 +67,11 @@ struct lorem_ipsum_provider final : resource_provider_interface {
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/lorem_ipsum");
+    }
 };
 //------------------------------------------------------------------------------
 auto lorem_ipsum_provider::has_resource(const url& locator) noexcept -> bool {
@@ -59,6 +59,11 @@ struct resource_list_provider final : resource_provider_interface {
 
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
+
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback("/resource_list");
+    }
 };
 //------------------------------------------------------------------------------
 auto resource_list_provider::has_resource(const url& locator) noexcept -> bool {
@@ -36,11 +36,17 @@ public:
     }
 
     auto fetch_fragment(span_size_t offs, memory::block dst) noexcept
-      -> span_size_t final;
+      -> span_size_t final {
+        return copy(head(skip(view(_text), offs), dst.size()), dst).size();
+    }
 
 private:
+    void _render_text() noexcept;
+
     const span_size_t _width;
     const span_size_t _height;
+    // the whole text of the finished tiling, from which fragments are served
+    memory::buffer _text;
 
     default_sudoku_board_traits<Rank> _traits{};
     basic_sudoku_tiling<Rank> _tiling{
@@ -67,6 +73,7 @@ auto tiling_io<Rank>::prepare() noexcept -> msgbus::blob_preparation_result {
         }
         _prepare_progress.update_progress(_fill.current_count());
         if(_fill.is_done()) {
+            _render_text();
             _prepare_progress.finish();
         }
         return {_fill.current_count(), _fill.total_count()};
@@ -75,29 +82,24 @@ auto tiling_io<Rank>::prepare() noexcept -> msgbus::blob_preparation_result {
 }
 //------------------------------------------------------------------------------
 template <unsigned Rank>
-auto tiling_io<Rank>::fetch_fragment(
-  span_size_t offs,
-  memory::block dst) noexcept -> span_size_t {
-    span_size_t done{0};
-    for(byte& b : dst) {
-        if(offs >= total_size()) [[unlikely]] {
-            break;
-        }
-        const auto x{int(offs % (_width + 1))};
-        if(x == _width) {
-            b = byte('\n');
-        } else {
-            const auto y{int(offs / (_width + 1))};
-            if(auto g{_traits.to_string(_patch.get_glyph(x, y))}) {
-                b = byte(g->front());
+void tiling_io<Rank>::_render_text() noexcept {
+    try {
+        _text.resize(total_size());
+    } catch(...) {
+        _text.clear();
+        return;
+    }
+    auto dst{_text.data()};
+    for(const auto y : integer_range(_height)) {
+        for(const auto x : integer_range(_width)) {
+            if(auto g{_traits.to_string(_patch.get_glyph(int(x), int(y)))}) {
+                *dst++ = byte(g->front());
             } else {
-                b = byte('.');
+                *dst++ = byte('.');
             }
         }
-        ++offs;
-        ++done;
+        *dst++ = byte('\n');
     }
-    return done;
 }
 //------------------------------------------------------------------------------
 // provider
@@ -139,9 +141,34 @@ public:
     auto get_blob_timeout(const span_size_t size) noexcept
       -> std::chrono::seconds final;
 
+    // the tiling is generated randomly and the board generator cannot be
+    // seeded, the cache_tag argument does not affect the generated tiling,
+    // it only names the first tiling generated for that tag, which is then
+    // pinned in the blob cache (and on disk if the cache has a directory)
+    // so that it is served unchanged for as long as the cache is kept.
+    // consumers needing the same tiling across runs have to pass a tag.
+    auto is_blob_cacheable(const url& locator) noexcept -> bool final {
+        return bool(locator.query().arg_value("cache_tag"));
+    }
+
+    auto is_blob_pinned(const url& locator) noexcept -> bool final {
+        return is_blob_cacheable(locator);
+    }
+
+    auto blob_cache_salt(const url&) noexcept -> std::string final {
+        return "text_tiling2";
+    }
+
+    auto blob_cache_locator(const url& locator) noexcept -> url final;
+
     void for_each_locator(
       callable_ref<void(string_view) noexcept>) noexcept final;
 
+    void for_each_served_path(
+      callable_ref<void(string_view) noexcept> callback) noexcept final {
+        callback(_path(unsigned_constant<Rank>{}));
+    }
+
 private:
     const shared_provider_objects& _shared;
 };
@@ -149,17 +176,40 @@ private:
 template <unsigned Rank>
 auto tiling_provider<Rank>::has_resource(const url& locator) noexcept -> bool {
     const auto& q{locator.query()};
+    const auto size{q.arg_value_as<span_size_t>("size").value_or(64)};
     return locator.has_path(_path(unsigned_constant<Rank>{})) and
-           q.arg_value_as<span_size_t>("size").value_or(64) > 0;
+           (q.arg_value_as<span_size_t>("width").value_or(size) > 0) and
+           (q.arg_value_as<span_size_t>("height").value_or(size) > 0);
 }
 //------------------------------------------------------------------------------
 template <unsigned Rank>
 auto tiling_provider<Rank>::get_resource_io(const url& locator)
   -> shared_holder<msgbus::source_blob_io> {
-    return {
-      hold<tiling_io<Rank>>,
-      as_parent(),
-      locator.query().arg_value_as<span_size_t>("size").value_or(64)};
+    const auto& q{locator.query()};
+    const auto size{q.arg_value_as<span_size_t>("size").value_or(64)};
+    return _shared.workers.prepare_in_background(
+      {hold<tiling_io<Rank>>,
+       as_parent(),
+       q.arg_value_as<span_size_t>("width").value_or(size),
+       q.arg_value_as<span_size_t>("height").value_or(size)});
+}
+//------------------------------------------------------------------------------
+// the size argument is only the default of the width and height
+template <unsigned Rank>
+auto tiling_provider<Rank>::blob_cache_locator(const url& locator) noexcept
+  -> url {
+    try {
+        const auto& q{locator.query()};
+        const auto size{q.arg_value_as<span_size_t>("size").value_or(64)};
+        return url{std::format(
+          "{}?width={}&height={}&cache_tag={}",
+          _loc(unsigned_constant<Rank>{}),
+          q.arg_value_as<span_size_t>("width").value_or(size),
+          q.arg_value_as<span_size_t>("height").value_or(size),
+          q.arg_value("cache_tag").or_default())};
+    } catch(...) {
+    }
+    return locator;
 }
 //------------------------------------------------------------------------------
 template <unsigned Rank>
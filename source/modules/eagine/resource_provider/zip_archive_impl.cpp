@@ -24,7 +24,10 @@ public:
     zipped_file(
       main_ctx_parent&,
       std::shared_ptr<::zip_t>,
-      string_view name) noexcept;
+      string_view name,
+      std::shared_ptr<memory_blob_cache> cache,
+      std::string cache_key,
+      span_size_t window_size) noexcept;
 
     auto size() noexcept -> span_size_t;
 
@@ -32,12 +35,33 @@ public:
 
 private:
     auto _get_content_size(::zip_t*, string_view) noexcept -> span_size_t;
-    auto _get_content() noexcept -> memory::const_block;
+    auto _open() noexcept -> bool;
+    void _skip(span_size_t count) noexcept;
+    template <typename Buffer>
+    auto _inflate_append(Buffer&, span_size_t count) noexcept -> span_size_t;
+    auto _read_cached(span_size_t offs, memory::block dst) noexcept
+      -> span_size_t;
+    auto _read_streamed(span_size_t offs, memory::block dst) noexcept
+      -> span_size_t;
 
     span_size_t _size;
-    main_ctx_buffer _content;
+    std::string _path;
     std::shared_ptr<::zip_t> _archive;
-    std::unique_ptr<::zip_file_t, int (*)(::zip_file_t*)> _file;
+    std::unique_ptr<::zip_file_t, int (*)(::zip_file_t*)> _file{
+      nullptr,
+      &::zip_fclose};
+    // offset of the next byte inflated from _file
+    span_size_t _stream_offs{0};
+
+    std::shared_ptr<memory_blob_cache> _cache;
+    const std::string _cache_key;
+    std::shared_ptr<const memory::buffer> _cached;
+    std::shared_ptr<memory::buffer> _accumulated;
+
+    // bounded window of inflated bytes for entries too large to be cached
+    main_ctx_buffer _window;
+    span_size_t _window_offs{0};
+    const span_size_t _window_size;
 };
 //------------------------------------------------------------------------------
 auto zipped_file::_get_content_size(::zip_t* archive, string_view path) noexcept
@@ -55,37 +79,160 @@ auto zipped_file::_get_content_size(::zip_t* archive, string_view path) noexcept
 zipped_file::zipped_file(
   main_ctx_parent& parent,
   std::shared_ptr<::zip_t> archive,
-  string_view path) noexcept
+  string_view path,
+  std::shared_ptr<memory_blob_cache> cache,
+  std::string cache_key,
+  span_size_t window_size) noexcept
   : main_ctx_object{"ZippedFile", parent}
   , _size{_get_content_size(archive.get(), path)}
-  , _content{*this}
+  , _path{to_string(path)}
   , _archive{std::move(archive)}
-  , _file{::zip_fopen(_archive.get(), c_str(path), 0), &::zip_fclose} {}
-//------------------------------------------------------------------------------
-auto zipped_file::_get_content() noexcept -> memory::const_block {
-    if(_content.empty()) {
-        if(_size > 0) {
-            _content.get(_size).resize(_size);
-            const auto sz{limit_cast<::zip_uint64_t>(_content.size())};
-            if(::zip_fread(_file.get(), _content.data(), sz) != sz) {
-                _content.clear();
+  , _cache{std::move(cache)}
+  , _cache_key{std::move(cache_key)}
+  , _window{*this}
+  , _window_size{std::max(window_size, span_size(4 * 1024))} {}
+//------------------------------------------------------------------------------
+auto zipped_file::_open() noexcept -> bool {
+    _file.reset(::zip_fopen(_archive.get(), _path.c_str(), 0));
+    _stream_offs = 0;
+    return bool(_file);
+}
+//------------------------------------------------------------------------------
+template <typename Buffer>
+auto zipped_file::_inflate_append(Buffer& buf, span_size_t count) noexcept
+  -> span_size_t {
+    if(not _file) {
+        return 0;
+    }
+    const auto old_size{buf.size()};
+    buf.resize(old_size + count);
+    const auto got{::zip_fread(
+      _file.get(), buf.data() + old_size, limit_cast<::zip_uint64_t>(count))};
+    const auto done{got > 0 ? span_size(got) : span_size(0)};
+    buf.resize(old_size + done);
+    _stream_offs += done;
+    return done;
+}
+//------------------------------------------------------------------------------
+void zipped_file::_skip(span_size_t count) noexcept {
+    std::array<byte, 16 * 1024> scratch{};
+    while(_file and (count > 0)) {
+        const auto chunk{std::min(count, span_size(scratch.size()))};
+        const auto got{::zip_fread(
+          _file.get(), scratch.data(), limit_cast<::zip_uint64_t>(chunk))};
+        if(got <= 0) {
+            break;
+        }
+        _stream_offs += span_size(got);
+        count -= span_size(got);
+    }
+}
+//------------------------------------------------------------------------------
+auto zipped_file::_read_cached(span_size_t offs, memory::block dst) noexcept
+  -> span_size_t {
+    if(not _cached) {
+        if(not _accumulated) {
+            if((_cached = _cache->find(_cache_key))) {
+                return _read_cached(offs, dst);
+            }
+            if(not _open()) {
+                return 0;
+            }
+            _accumulated = std::make_shared<memory::buffer>();
+            _accumulated->reserve(_size);
+        }
+        const auto end{std::min(offs + dst.size(), _size)};
+        while(_stream_offs < end) {
+            if(_inflate_append(*_accumulated, end - _stream_offs) == 0) {
+                break;
+            }
+        }
+        if(_stream_offs >= _size) {
+            _file.reset();
+            _cached = std::move(_accumulated);
+            _cache->insert(_cache_key, _cached);
+        }
+    }
+    const auto& content{_cached ? *_cached : *_accumulated};
+    return copy(head(skip(view(content), offs), dst.size()), dst).size();
+}
+//------------------------------------------------------------------------------
+auto zipped_file::_read_streamed(span_size_t offs, memory::block dst) noexcept
+  -> span_size_t {
+    const auto window_end{_window_offs + _window.size()};
+    if((offs < _window_offs) or (offs + dst.size() > window_end)) {
+        if(not _file or (offs < _stream_offs)) {
+            if(not _open()) {
+                return 0;
+            }
+        }
+        _skip(offs - _stream_offs);
+        _window.clear();
+        _window_offs = _stream_offs;
+        const auto count{std::min(
+          std::max(_window_size, dst.size()), _size - _stream_offs)};
+        while(_window.size() < count) {
+            if(_inflate_append(_window, count - _window.size()) == 0) {
+                break;
             }
         }
     }
-    return memory::view(_content);
+    return copy(
+             head(skip(view(_window), offs - _window_offs), dst.size()), dst)
+      .size();
 }
 //------------------------------------------------------------------------------
 auto zipped_file::size() noexcept -> span_size_t {
-    return _get_content().size();
+    return _size;
 }
 //------------------------------------------------------------------------------
 auto zipped_file::read(span_size_t offs, memory::block dst) noexcept
   -> span_size_t {
-    const auto src{skip(_get_content(), offs)};
-    dst = head(dst, src);
-    return copy(head(src, dst), dst).size();
+    if((offs < 0) or (offs >= _size)) {
+        return 0;
+    }
+    dst = head(dst, _size - offs);
+    if(_size <= _cache->max_entry_size()) {
+        return _read_cached(offs, dst);
+    }
+    return _read_streamed(offs, dst);
 }
 //------------------------------------------------------------------------------
+// aligned_zip_io
+//------------------------------------------------------------------------------
+struct aligned_zip_entry {
+    std::string name;
+    span_size_t offset{0};
+    span_size_t size{0};
+};
+//------------------------------------------------------------------------------
+class aligned_zip_io final : public msgbus::source_blob_io {
+public:
+    aligned_zip_io(
+      std::shared_ptr<shared_file> file,
+      const aligned_zip_entry& entry) noexcept
+      : _file{std::move(file)}
+      , _offset{entry.offset}
+      , _size{entry.size} {}
+
+    auto total_size() noexcept -> span_size_t final {
+        return _size;
+    }
+
+    auto fetch_fragment(span_size_t offs, memory::block dst) noexcept
+      -> span_size_t final {
+        if((offs < 0) or (offs >= _size)) {
+            return 0;
+        }
+        return _file->read(_offset + offs, head(dst, _size - offs));
+    }
+
+private:
+    std::shared_ptr<shared_file> _file;
+    const span_size_t _offset;
+    const span_size_t _size;
+};
+//------------------------------------------------------------------------------
 // zip_archive
 //------------------------------------------------------------------------------
 class zip_archive : public main_ctx_object {
@@ -93,19 +240,41 @@ public:
     zip_archive(main_ctx_parent&, const std::filesystem::path& path, int);
 
     explicit operator bool() noexcept {
-        return bool(_archive);
+        return bool(_archive) or is_aligned();
+    }
+
+    auto is_aligned() const noexcept -> bool {
+        return bool(_aligned_file);
     }
 
+    auto find_aligned(string_view path) const noexcept
+      -> optional_reference<const aligned_zip_entry>;
+
+    auto has_file(string_view path) noexcept -> bool;
+
+    auto open_io(
+      string_view path,
+      std::shared_ptr<memory_blob_cache> cache,
+      span_size_t window_size) noexcept -> shared_holder<msgbus::source_blob_io>;
+
     auto handle() noexcept {
         return _archive.get();
     }
 
-    auto open_file(string_view path) noexcept -> unique_holder<zipped_file>;
+    auto open_file(
+      string_view path,
+      std::shared_ptr<memory_blob_cache> cache,
+      span_size_t window_size) noexcept -> unique_holder<zipped_file>;
 
     void for_each_file(
       callable_ref<void(string_view) noexcept> callback) noexcept;
 
 private:
+    auto _load_aligned_index(const std::filesystem::path&) noexcept -> bool;
+
+    std::string _path;
+    std::shared_ptr<shared_file> _aligned_file;
+    std::vector<aligned_zip_entry> _aligned_entries;
     std::shared_ptr<::zip_t> _archive;
 };
 //------------------------------------------------------------------------------
@@ -114,15 +283,171 @@ zip_archive::zip_archive(
   const std::filesystem::path& path,
   int ec = 0)
   : main_ctx_object{"ZipArchive", parent}
-  , _archive{::zip_open(path.string().c_str(), 0, &ec), &::zip_close} {}
+  , _path{path.string()} {
+    if(not _load_aligned_index(path)) {
+        _archive.reset(::zip_open(_path.c_str(), 0, &ec), &::zip_close);
+    }
+}
+//------------------------------------------------------------------------------
+static inline auto zip_read_le(
+  memory::const_block data,
+  span_size_t offs,
+  span_size_t bytes) noexcept -> std::uint64_t {
+    std::uint64_t result{0U};
+    for(span_size_t i = bytes; i > 0; --i) {
+        result = (result << 8U) | std::uint64_t(data[offs + i - 1]);
+    }
+    return result;
+}
 //------------------------------------------------------------------------------
-auto zip_archive::open_file(string_view path) noexcept
-  -> unique_holder<zipped_file> {
-    return {default_selector, as_parent(), _archive, path};
+auto zip_archive::_load_aligned_index(const std::filesystem::path& path) noexcept
+  -> bool {
+    // The aligned layout produced by app-pack-eagizip.py starts with a stored
+    // entry named .eagizip_index listing the data offset and size of every
+    // other (stored and aligned) entry, sorted by name.
+    std::error_code error{};
+    const auto file_size{std::filesystem::file_size(path, error)};
+    if(error) {
+        return false;
+    }
+    // the packed archives are immutable bundles, replaced as a whole and
+    // not truncated in place, so the entries are copied from a mapping
+    auto file{std::make_shared<shared_file>(
+      path,
+      limit_cast<span_size_t>(file_size),
+      std::filesystem::last_write_time(path, error),
+      true)};
+
+    const string_view index_name{".eagizip_index"};
+    const span_size_t header_size{30};
+    std::vector<byte> header(std_size(header_size + index_name.size()));
+    const memory::block data{header.data(), span_size(header.size())};
+    if(file->read(0, data) < data.size()) {
+        return false;
+    }
+    if(zip_read_le(data, 0, 4) != 0x04034b50U) {
+        return false;
+    }
+    const auto method{zip_read_le(data, 8, 2)};
+    const auto stored_size{span_size(zip_read_le(data, 18, 4))};
+    const auto name_len{span_size(zip_read_le(data, 26, 2))};
+    const auto extra_len{span_size(zip_read_le(data, 28, 2))};
+    if((method != 0U) or (name_len != index_name.size())) {
+        return false;
+    }
+    if(not are_equal(
+         as_chars(head(skip(data, header_size), name_len)), index_name)) {
+        return false;
+    }
+    const auto index_offs{header_size + name_len + extra_len};
+    if(index_offs + stored_size > file->size()) {
+        return false;
+    }
+    std::string index_data(std_size(stored_size), '\0');
+    if(
+      file->read(
+        index_offs,
+        {reinterpret_cast<byte*>(index_data.data()), stored_size}) <
+      stored_size) {
+        return false;
+    }
+    std::string_view text{index_data};
+
+    const auto next_line{[&]() -> std::string_view {
+        const auto pos{text.find('\n')};
+        auto line{text.substr(0, pos)};
+        text.remove_prefix(
+          pos == std::string_view::npos ? text.size() : pos + 1U);
+        return line;
+    }};
+    if(not next_line().starts_with("eagizip-index 1")) {
+        return false;
+    }
+
+    std::vector<aligned_zip_entry> entries;
+    while(not text.empty()) {
+        const auto line{next_line()};
+        if(line.empty()) {
+            continue;
+        }
+        // <offset:16 hex> <size:16 hex> <name>
+        if((line.size() < 35U) or (line[16] != ' ') or (line[33] != ' ')) {
+            return false;
+        }
+        std::uint64_t offset{0U};
+        std::uint64_t size{0U};
+        std::from_chars(line.data(), line.data() + 16, offset, 16);
+        std::from_chars(line.data() + 17, line.data() + 33, size, 16);
+        if(offset + size > file_size) {
+            return false;
+        }
+        entries.push_back(
+          {.name = std::string{line.substr(34)},
+           .offset = span_size(offset),
+           .size = span_size(size)});
+    }
+    if(not std::is_sorted(
+         entries.begin(), entries.end(), [](const auto& l, const auto& r) {
+             return l.name < r.name;
+         })) {
+        return false;
+    }
+    _aligned_entries = std::move(entries);
+    _aligned_file = std::move(file);
+    log_info("using aligned archive layout of '${path}'")
+      .arg("path", "FsPath", _path)
+      .arg("count", span_size(_aligned_entries.size()));
+    return true;
+}
+//------------------------------------------------------------------------------
+auto zip_archive::find_aligned(string_view path) const noexcept
+  -> optional_reference<const aligned_zip_entry> {
+    const std::string_view name{path};
+    const auto pos{std::lower_bound(
+      _aligned_entries.begin(),
+      _aligned_entries.end(),
+      name,
+      [](const auto& entry, std::string_view n) { return entry.name < n; })};
+    if((pos != _aligned_entries.end()) and (pos->name == name)) {
+        return {*pos};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
+auto zip_archive::has_file(string_view path) noexcept -> bool {
+    if(is_aligned()) {
+        if(const auto entry{find_aligned(path)}) {
+            return entry->size > 0;
+        }
+        return false;
+    }
+    ::zip_stat_t s{};
+    ::zip_stat_init(&s);
+    if(::zip_stat(_archive.get(), c_str(path), ZIP_STAT_SIZE, &s) == 0) {
+        return s.size > 0;
+    }
+    return false;
+}
+//------------------------------------------------------------------------------
+auto zip_archive::open_file(
+  string_view path,
+  std::shared_ptr<memory_blob_cache> cache,
+  span_size_t window_size) noexcept -> unique_holder<zipped_file> {
+    return {
+      default_selector,
+      as_parent(),
+      _archive,
+      path,
+      std::move(cache),
+      std::format("{}:{}", _path, std::string_view{path}),
+      window_size};
 }
 //------------------------------------------------------------------------------
 void zip_archive::for_each_file(
   callable_ref<void(string_view) noexcept> callback) noexcept {
+    for(const auto& entry : _aligned_entries) {
+        callback(entry.name);
+    }
     if(_archive) {
         const auto count{::zip_get_num_entries(_archive.get(), 0)};
         for(::zip_int64_t i = 0; i < count; ++i) {
@@ -162,6 +487,22 @@ auto zip_archive_io::fetch_fragment(span_size_t offs, memory::block dst) noexcep
     return 0;
 }
 //------------------------------------------------------------------------------
+auto zip_archive::open_io(
+  string_view path,
+  std::shared_ptr<memory_blob_cache> cache,
+  span_size_t window_size) noexcept -> shared_holder<msgbus::source_blob_io> {
+    if(is_aligned()) {
+        if(const auto entry{find_aligned(path)}) {
+            return {hold<aligned_zip_io>, _aligned_file, *entry};
+        }
+        return {};
+    }
+    if(auto file{open_file(path, std::move(cache), window_size)}) {
+        return {hold<zip_archive_io>, std::move(file)};
+    }
+    return {};
+}
+//------------------------------------------------------------------------------
 // provider
 //------------------------------------------------------------------------------
 class zip_archive_provider final
@@ -185,7 +526,7 @@ private:
     auto _search_archive(std::filesystem::path, const url&) noexcept
       -> std::tuple<optional_reference<zip_archive>, std::string>;
     auto _search_archive_file(std::filesystem::path, const url&) noexcept
-      -> shared_holder<zipped_file>;
+      -> shared_holder<msgbus::source_blob_io>;
 
     auto _is_zip_archive(const std::filesystem::path& path) noexcept -> bool;
 
@@ -200,11 +541,22 @@ private:
     std::string _hostname;
     filesystem_search_paths _search_paths;
     flat_map<std::filesystem::path, zip_archive> _open_archives;
+    std::shared_ptr<memory_blob_cache> _entry_cache;
+    application_config_value<span_size_t> _window_size;
 };
 //------------------------------------------------------------------------------
 zip_archive_provider::zip_archive_provider(const provider_parameters& params)
   : main_ctx_object{"FilePrvdr", params.parent}
-  , _search_paths{"ZipSrchPth", as_parent()} {}
+  , _search_paths{"ZipSrchPth", as_parent()}
+  , _entry_cache{std::make_shared<memory_blob_cache>(
+      "ZipEntCach",
+      as_parent(),
+      "application.resource_provider.zip.cache_size",
+      span_size(64 * 1024 * 1024))}
+  , _window_size{
+      main_context().config(),
+      "application.resource_provider.zip.window_size",
+      span_size(256 * 1024)} {}
 //------------------------------------------------------------------------------
 auto zip_archive_provider::_get_archive(
   const std::filesystem::path& path) noexcept
@@ -276,9 +628,9 @@ auto zip_archive_provider::_search_archive(
 //------------------------------------------------------------------------------
 auto zip_archive_provider::_search_archive_file(
   std::filesystem::path archive_path,
-  const url& locator) noexcept -> shared_holder<zipped_file> {
+  const url& locator) noexcept -> shared_holder<msgbus::source_blob_io> {
     if(auto [zip, file_path]{_search_archive(archive_path, locator)}; zip) {
-        return zip->open_file(file_path);
+        return zip->open_io(file_path, _entry_cache, _window_size.value());
     }
     return {};
 }
@@ -287,11 +639,7 @@ auto zip_archive_provider::_has_resource(
   std::filesystem::path archive_path,
   const url& locator) noexcept -> bool {
     if(auto [zip, file_path]{_search_archive(archive_path, locator)}; zip) {
-        ::zip_stat_t s{};
-        ::zip_stat_init(&s);
-        if(::zip_stat(zip->handle(), file_path.c_str(), ZIP_STAT_SIZE, &s) == 0) {
-            return s.size > 0;
-        }
+        return zip->has_file(file_path);
     }
     return false;
 }
@@ -308,8 +656,8 @@ auto zip_archive_provider::has_resource(const url& locator) noexcept -> bool {
 auto zip_archive_provider::get_resource_io(const url& locator)
   -> shared_holder<msgbus::source_blob_io> {
     for(const auto& search_path : _search_paths) {
-        if(auto zip{_search_archive_file(std::move(search_path), locator)}) {
-            return {hold<zip_archive_io>, std::move(zip)};
+        if(auto io{_search_archive_file(search_path, locator)}) {
+            return io;
         }
     }
     return {};
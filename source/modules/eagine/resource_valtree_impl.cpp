@@ -41,7 +41,11 @@ struct valtree_resource::_loader final : simple_loader_of<valtree_resource> {
 
     void resource_loaded(const load_info&) noexcept final;
 
+    void _parse(bool json, bool yaml) noexcept;
+    void _finish() noexcept;
+
     plain_text_resource _text;
+    valtree::compound _tree;
 };
 //------------------------------------------------------------------------------
 auto valtree_resource::_loader::request_dependencies() noexcept
@@ -51,21 +55,31 @@ auto valtree_resource::_loader::request_dependencies() noexcept
 }
 //------------------------------------------------------------------------------
 void valtree_resource::_loader::resource_loaded(const load_info& info) noexcept {
-    if(info.locator.has_path_suffix(".json") or info.locator.has_scheme("json")) {
-        if(auto tree{valtree::from_json_text(_text.get(), main_ctx::get())}) {
-            resource()._private_ref() = std::move(tree);
-            mark_loaded();
-            return;
-        }
+    const bool json{
+      info.locator.has_path_suffix(".json") or info.locator.has_scheme("json")};
+    const bool yaml{
+      info.locator.has_path_suffix(".yaml") or info.locator.has_scheme("yaml")};
+    // parsing of large documents would stall the rendering thread
+    finish_in_background(
+      [this, json, yaml] { _parse(json, yaml); }, [this] { _finish(); });
+}
+//------------------------------------------------------------------------------
+void valtree_resource::_loader::_parse(bool json, bool yaml) noexcept {
+    if(json) {
+        _tree = valtree::from_json_text(_text.get(), main_ctx::get());
     }
-    if(info.locator.has_path_suffix(".yaml") or info.locator.has_scheme("yaml")) {
-        if(auto tree{valtree::from_yaml_text(_text.get(), main_ctx::get())}) {
-            resource()._private_ref() = std::move(tree);
-            mark_loaded();
-            return;
-        }
+    if(yaml and not _tree) {
+        _tree = valtree::from_yaml_text(_text.get(), main_ctx::get());
+    }
+}
+//------------------------------------------------------------------------------
+void valtree_resource::_loader::_finish() noexcept {
+    if(_tree) {
+        resource()._private_ref() = std::move(_tree);
+        mark_loaded();
+    } else {
+        mark_error();
     }
-    mark_error();
 }
 //------------------------------------------------------------------------------
 auto valtree_resource::make_loader(
@@ -122,7 +136,7 @@ struct visited_valtree_resource::_loader final
 auto visited_valtree_resource::_loader::request_dependencies() noexcept
   -> valid_if_not_zero<identifier_t> {
     return add_single_loader_dependency(
-      parent_loader().fetch_resource_chunks(parameters(), 1024).first);
+      parent_loader().fetch_shared_chunks(parameters(), 1024));
 }
 //------------------------------------------------------------------------------
 void visited_valtree_resource::_loader::stream_data_appended(
@@ -435,7 +435,7 @@ class Framedump(object):
             "-([0-9]+)x([0-9]+)x([0-9]+)"+
             "-(rgba|depth|stencil)"+
             "-(byte|float)"+
-            "-([0-9]+)((.zlib)?)$")
+            "-([0-9]+)((.zlib|.rle)?)$")
 
         cmd_line = [
             options.application_path,
@@ -504,6 +504,7 @@ class Framedump(object):
                         "type": match.group(6),
                         "frame": int(match.group(7)),
                         "zlib": match.group(9) == ".zlib",
+                        "rle": match.group(9) == ".rle",
                         "prefix": frame_path_raw[:-len(match.group(8))],
                         "path": frame_path_raw
                     }
@@ -515,6 +516,20 @@ class Framedump(object):
         # TODO: properly translate mode and type into imagemagick format
         return info["mode"]
 
+    # -------------------------------------------------------------------------
+    def decodeRunLength(self, data):
+        result = bytearray()
+        pos = 0
+        while pos < len(data):
+            control = data[pos]
+            if control < 128:
+                result += data[pos + 1:pos + control + 2]
+                pos += control + 2
+            else:
+                result += data[pos + 1:pos + 2] * (control - 125)
+                pos += 2
+        return bytes(result)
+
     # -------------------------------------------------------------------------
     def framesToPng(self):
         for info in self.generateFrames():
@@ -533,6 +548,12 @@ class Framedump(object):
                             rdata = zobj.decompress(zdata)
                             if rdata: unzipped.write(rdata)
                         del zobj
+            elif info["rle"]:
+                with open(info["path"], "rb") as packed:
+                    os.unlink(info["path"])
+                    info["path"] = info["prefix"] + ".raw"
+                    with open(info["path"], "wb") as unpacked:
+                        unpacked.write(self.decodeRunLength(packed.read()))
             assert os.path.isfile(info["path"])
 
             png_path = os.path.join(
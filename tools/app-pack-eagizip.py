@@ -0,0 +1,189 @@
+#!/usr/bin/python3
+# coding=utf-8
+# Copyright Matus Chochlik.
+# Distributed under the Boost Software License, Version 1.0.
+# See accompanying file LICENSE_1_0.txt or copy at
+# https://www.boost.org/LICENSE_1_0.txt
+#
+import os
+import sys
+import struct
+import zipfile
+import argparse
+
+# ------------------------------------------------------------------------------
+indexName = ".eagizip_index"
+localHeaderSize = 30
+alignExtraId = 0xD935
+# ------------------------------------------------------------------------------
+class PackArgumentParser(argparse.ArgumentParser):
+    # -------------------------------------------------------------------------
+    def __init__(self, **kw):
+        argparse.ArgumentParser.__init__(self, **kw)
+
+        def PowerOfTwo(arg):
+            try:
+                result = int(arg)
+                assert result > 0 and (result & (result - 1)) == 0
+                return result
+            except:
+                msg = "'%s' is not a positive power of two" % str(arg)
+                raise argparse.ArgumentTypeError(msg)
+
+        self.add_argument(
+            "--print-bash-completion",
+            metavar='FILE|-',
+            dest='print_bash_completion',
+            default=None
+        )
+
+        self.add_argument(
+            "--output", "-o",
+            metavar='EAGIZIP-PATH',
+            dest='output_path',
+            type=os.path.realpath,
+            default=None,
+            help="""
+                Path of the output archive.
+            """
+        )
+
+        self.add_argument(
+            "--alignment", "-a",
+            metavar='BYTES',
+            dest='alignment',
+            type=PowerOfTwo,
+            default=4096,
+            help="""
+                Alignment of the stored entry data in the archive.
+                Should be a multiple of the page size to allow serving
+                the entries directly from a memory mapping.
+                Default: %(default)s.
+            """
+        )
+
+        self.add_argument(
+            "input_paths",
+            metavar='FILE',
+            type=os.path.realpath,
+            nargs='*',
+            help="""
+                Input files. Only the base names are stored in the archive.
+            """
+        )
+
+    # -------------------------------------------------------------------------
+    def parseArgs(self):
+        options = argparse.ArgumentParser.parse_args(self)
+        if not options.print_bash_completion:
+            if options.output_path is None:
+                self.error("missing output path")
+        return options
+# ------------------------------------------------------------------------------
+def getArgumentParser():
+    return PackArgumentParser(
+        prog=os.path.basename(__file__),
+        description="""
+        Packs files into an .eagizip archive with uncompressed, aligned entries
+        and a sorted name index, that the resource provider can serve directly
+        from a memory mapping of the archive.
+        """
+    )
+# ------------------------------------------------------------------------------
+def alignmentExtra(offset, name, alignment):
+    base = offset + localHeaderSize + len(name.encode("utf-8"))
+    padding = (-base) % alignment
+    if 0 < padding < 4:
+        padding += alignment
+    if padding == 0:
+        return b""
+    return struct.pack("<HH", alignExtraId, padding - 4) + bytes(padding - 4)
+# ------------------------------------------------------------------------------
+def indexSize(names, alignment):
+    size = len(indexHeader(alignment))
+    for name in names:
+        size += 16 + 1 + 16 + 1 + len(name.encode("utf-8")) + 1
+    return size
+# ------------------------------------------------------------------------------
+def indexHeader(alignment):
+    return "eagizip-index 1 %d\n" % alignment
+# ------------------------------------------------------------------------------
+def makeLayout(entries, alignment):
+    names = [name for name, path, size in entries]
+    layout = []
+    offset = 0
+    for name, size in [(indexName, indexSize(names, alignment))] + \
+        [(name, size) for name, path, size in entries]:
+        extra = alignmentExtra(offset, name, alignment)
+        dataOffset = offset + localHeaderSize + len(name.encode("utf-8")) + len(extra)
+        layout.append((name, extra, dataOffset, size))
+        offset = dataOffset + size
+    return layout
+# ------------------------------------------------------------------------------
+def makeIndex(layout, alignment):
+    lines = [indexHeader(alignment)]
+    for name, extra, dataOffset, size in layout[1:]:
+        lines.append("%016x %016x %s\n" % (dataOffset, size, name))
+    return "".join(lines).encode("utf-8")
+# ------------------------------------------------------------------------------
+def packArchive(options):
+    entries = {}
+    for path in options.input_paths:
+        name = os.path.basename(path)
+        if name in entries:
+            raise RuntimeError("duplicate entry name '%s'" % name)
+        entries[name] = (name, path, os.path.getsize(path))
+    entries = [entries[name] for name in sorted(entries.keys())]
+
+    layout = makeLayout(entries, options.alignment)
+    index = makeIndex(layout, options.alignment)
+    assert len(index) == layout[0][3]
+
+    with zipfile.ZipFile(options.output_path, "w", zipfile.ZIP_STORED) as zfd:
+        for (name, extra, dataOffset, size), content in zip(
+            layout,
+            [lambda: index] + [
+                (lambda p: lambda: open(p, "rb").read())(path)
+                for name, path, size in entries]):
+            info = zipfile.ZipInfo(name, date_time=(1980, 1, 1, 0, 0, 0))
+            info.compress_type = zipfile.ZIP_STORED
+            info.extra = extra
+            zfd.writestr(info, content())
+
+    with zipfile.ZipFile(options.output_path, "r") as zfd:
+        for (name, extra, dataOffset, size), info in zip(layout, zfd.infolist()):
+            actual = info.header_offset + localHeaderSize + \
+                len(info.filename.encode("utf-8")) + len(info.extra)
+            if info.filename != name or actual != dataOffset:
+                raise RuntimeError("unexpected layout of entry '%s'" % name)
+# ------------------------------------------------------------------------------
+#  Argparse utilities
+# ------------------------------------------------------------------------------
+def printBashCompletion(argparser, options):
+    from eagine.argparseUtil import printBashComplete
+    def _printIt(fd):
+        printBashComplete(
+            argparser,
+            "_eagine_app_pack_eagizip",
+            "eagine-app-pack-eagizip",
+            ["--print-bash-completion"],
+            fd)
+    if options.print_bash_completion == "-":
+        _printIt(sys.stdout)
+    else:
+        with open(options.print_bash_completion, "wt") as fd:
+            _printIt(fd)
+
+# ------------------------------------------------------------------------------
+def main():
+    argparser = getArgumentParser()
+    options = argparser.parseArgs()
+    if options.print_bash_completion:
+        printBashCompletion(argparser, options)
+        return 0
+
+    packArchive(options)
+    return 0
+# ------------------------------------------------------------------------------
+if __name__ == "__main__":
+        sys.exit(main())